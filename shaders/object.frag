@@ -1,24 +1,34 @@
 #version 450 core
 
+// Feature defines: see object.vert
+
 in vec3 fragPos;
 in vec3 vNormal;
+flat in vec3 vColor;  // per draw
 
 out vec4 fragColor;
 
-uniform vec3 objectColor;
-uniform vec3 lightDir;    // normalized, points FROM light (toward scene)
-uniform vec3 lightColor;
-uniform float ambientStrength;
+// Per-frame data, see rendering/UniformBuffer.h
+layout(std140, binding = 0) uniform Frame {
+    mat4 view;
+    mat4 projection;
+    vec4 lightDir;    // xyz normalized, points FROM light (toward scene)
+    vec4 lightColor;  // rgb; a = ambient strength
+};
 
 void main()
 {
+#ifdef NO_LIGHTING
+    fragColor = vec4(vColor, 1.0);
+#else
     vec3 N = normalize(vNormal);
-    vec3 L = normalize(-lightDir);
+    vec3 L = normalize(-lightDir.xyz);
 
     float diff = max(dot(N, L), 0.0);
-    vec3 ambient  = ambientStrength * lightColor;
-    vec3 diffuse  = diff * lightColor;
+    vec3 ambient  = lightColor.a * lightColor.rgb;
+    vec3 diffuse  = diff * lightColor.rgb;
 
-    vec3 result = (ambient + diffuse) * objectColor;
+    vec3 result = (ambient + diffuse) * vColor;
     fragColor = vec4(result, 1.0);
+#endif
 }
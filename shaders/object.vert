@@ -1,19 +1,74 @@
 #version 450 core
+#extension GL_ARB_shader_draw_parameters : require
 
-layout(location = 0) in vec3 aPos;
-layout(location = 1) in vec3 aNormal;
+// Feature defines, injected by Shader after #version:
+//   RIGID_TRANSFORM_ONLY  every instance has scale 1: rotation + translation only
+//   NO_LIGHTING           unlit; skip normal decode (must match object.frag)
+
+// Packed vertex, see rendering/MeshFormat.h
+layout(location = 0) in vec3 aPos;        // half floats
+layout(location = 1) in vec2 aNormalOct;  // octahedral, snorm16
 
 out vec3 fragPos;
 out vec3 vNormal;
+flat out vec3 vColor;
+
+// Per-instance transform, see rendering/InstanceBuffer.h
+struct Instance {
+    vec4 positionScale;  // xyz = position, w = uniform scale
+    vec4 rotation;       // unit quaternion (x, y, z, w)
+};
+
+layout(std430, binding = 0) readonly buffer Instances {
+    Instance instances[];
+};
+
+// Per-draw data, see rendering/GeometryArena.h; indexed by gl_DrawIDARB
+struct Draw {
+    vec4 color;
+};
+
+layout(std430, binding = 1) readonly buffer Draws {
+    Draw draws[];
+};
+
+// Per-frame data, see rendering/UniformBuffer.h
+layout(std140, binding = 0) uniform Frame {
+    mat4 view;
+    mat4 projection;
+    vec4 lightDir;
+    vec4 lightColor;
+};
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+vec3 octDecode(vec2 e)
+{
+    vec3  n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+    return normalize(n);
+}
+
+vec3 rotate(vec4 q, vec3 v)
+{
+    return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
+}
 
 void main()
 {
-    vec4 worldPos = model * vec4(aPos, 1.0);
-    fragPos = vec3(worldPos);
-    vNormal = mat3(transpose(inverse(model))) * aNormal;
-    gl_Position = projection * view * worldPos;
+    // baseInstance of the indirect command = this draw's first slot
+    Instance inst = instances[gl_BaseInstanceARB + gl_InstanceID];
+
+#ifdef RIGID_TRANSFORM_ONLY
+    vec3 worldPos = inst.positionScale.xyz + rotate(inst.rotation, aPos);
+#else
+    vec3 worldPos = inst.positionScale.xyz + rotate(inst.rotation, aPos * inst.positionScale.w);
+#endif
+    fragPos = worldPos;
+#ifdef NO_LIGHTING
+    vNormal = vec3(0.0);
+#else
+    vNormal = rotate(inst.rotation, octDecode(aNormalOct));  // rotation + uniform scale: no inverse-transpose
+#endif
+    vColor  = draws[gl_DrawIDARB].color.rgb;
+    gl_Position = projection * view * vec4(worldPos, 1.0);
 }
@@ -0,0 +1,55 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<std::uint64_t> g_allocations{0};
+
+std::uint64_t heapAllocations()
+{
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+// The array and nothrow forms forward to these.
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// Over-allocate and keep malloc's pointer just below the aligned block:
+// std::aligned_alloc isn't available on MSVC
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t a   = static_cast<std::size_t>(alignment);
+    void*             raw = std::malloc(size + a + sizeof(void*));
+    if (!raw) throw std::bad_alloc();
+
+    const auto at = (reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*) + a - 1) & ~(a - 1);
+    reinterpret_cast<void**>(at)[-1] = raw;
+    return reinterpret_cast<void*>(at);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    if (p) std::free(static_cast<void**>(p)[-1]);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t alignment) noexcept
+{
+    operator delete(p, alignment);
+}
@@ -0,0 +1,7 @@
+#pragma once
+#include <cstdint>
+
+// Heap allocations made by the whole process so far, through any form of
+// operator new. Linking AllocationCounter.cpp replaces the global
+// operator new/delete; the count is all it adds.
+std::uint64_t heapAllocations();
@@ -0,0 +1,286 @@
+// Headless physics throughput benchmark; no window or GL context needed.
+//
+//   physics-bench [--bodies N[,N...]] [--ticks K] [--threads T] [--iterations I]
+//                 [--hz H] [--no-sleep] [--no-ccd] [--rollback] [--snapshot FILE]
+//                 [--write-snapshot FILE] [--trace FILE]
+//
+// Defaults: 8 → 1M bodies (×8 per row), 120 ticks each at 60 Hz,
+// all hardware threads, SimParams' solver iterations.
+// --hz sets the fixed step; --no-ccd turns off continuous collision.
+// --snapshot runs the saved scene instead of the generated ones and reports
+// the load time; --write-snapshot saves the first --bodies scene and exits.
+// --trace records every phase of every tick as a Chrome trace.
+// --rollback steps through a RollbackRing instead and times restoring the
+// state from 8 ticks back and replaying to the present, checking the
+// replay ends bit-identical to the first run.
+//
+// "allocs" counts heap allocations inside stepSimulation() after the first
+// tick of a run; it stays 0 unless a tick outgrows the FrameArena or the
+// broadphase's per-chunk lists (a new high-water mark).
+
+#include "core/Profiler.h"
+#include "core/Rollback.h"
+#include "core/Simulation.h"
+#include "core/Snapshot.h"
+#include "core/ThreadPool.h"
+#include "platform/MappedFile.h"
+#include "AllocationCounter.h"
+#include "Scenes.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+struct BenchOptions {
+    std::vector<std::size_t> bodyCounts{8, 64, 512, 4096, 32768, 262144, 1048576};
+    int                      ticks{120};
+    unsigned                 threads{0};
+    int                      iterations{SimParams{}.velocityIterations};
+    float                    hz{60.0f};
+    bool                     sleep{true};
+    bool                     ccd{true};
+    bool                     rollback{false};
+    const char*              snapshotPath{nullptr};
+    const char*              writeSnapshotPath{nullptr};
+    const char*              tracePath{nullptr};
+};
+
+static void usage(const char* argv0)
+{
+    std::fprintf(stderr,
+                 "usage: %s [--bodies N[,N...]] [--ticks K] [--threads T] [--iterations I]\n"
+                 "       [--hz H] [--no-sleep] [--no-ccd] [--rollback] [--snapshot FILE]"
+                 " [--write-snapshot FILE] [--trace FILE]\n", argv0);
+}
+
+static bool parseArgs(int argc, char* argv[], BenchOptions& opt)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* arg  = argv[i];
+        const char* next = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(arg, "--bodies") == 0 && next) {
+            opt.bodyCounts.clear();
+            std::string list(next);
+            std::size_t pos = 0;
+            while (pos < list.size()) {
+                std::size_t comma = list.find(',', pos);
+                if (comma == std::string::npos) comma = list.size();
+                opt.bodyCounts.push_back(std::strtoull(list.c_str() + pos, nullptr, 10));
+                pos = comma + 1;
+            }
+            ++i;
+        } else if (std::strcmp(arg, "--ticks") == 0 && next) {
+            opt.ticks = std::atoi(next);
+            ++i;
+        } else if (std::strcmp(arg, "--threads") == 0 && next) {
+            opt.threads = static_cast<unsigned>(std::atoi(next));
+            ++i;
+        } else if (std::strcmp(arg, "--iterations") == 0 && next) {
+            opt.iterations = std::atoi(next);
+            ++i;
+        } else if (std::strcmp(arg, "--hz") == 0 && next) {
+            opt.hz = static_cast<float>(std::atof(next));
+            ++i;
+        } else if (std::strcmp(arg, "--no-sleep") == 0) {
+            opt.sleep = false;
+        } else if (std::strcmp(arg, "--no-ccd") == 0) {
+            opt.ccd = false;
+        } else if (std::strcmp(arg, "--rollback") == 0) {
+            opt.rollback = true;
+        } else if (std::strcmp(arg, "--snapshot") == 0 && next) {
+            opt.snapshotPath = next;
+            ++i;
+        } else if (std::strcmp(arg, "--write-snapshot") == 0 && next) {
+            opt.writeSnapshotPath = next;
+            ++i;
+        } else if (std::strcmp(arg, "--trace") == 0 && next) {
+            opt.tracePath = next;
+            ++i;
+        } else {
+            return false;
+        }
+    }
+    for (std::size_t n : opt.bodyCounts)
+        if (n == 0) return false;  // also what non-numeric text parses to
+    return opt.ticks > 0 && opt.iterations > 0 && opt.hz > 0.0f && !opt.bodyCounts.empty();
+}
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static void runTicks(SimState& sim, const BenchOptions& opt, float dt)
+{
+    const std::size_t n = sim.bodies.size();
+    std::size_t pairs = 0, contacts = 0, floor = 0, awake = 0, swept = 0, arena = 0;
+    std::uint64_t allocs = 0;
+
+    auto start = Clock::now();
+    for (int t = 0; t < opt.ticks; ++t) {
+        const std::uint64_t before = heapAllocations();
+        stepSimulation(sim, dt);
+        if (t > 0) allocs += heapAllocations() - before;
+        pairs    += sim.stats.pairsTested;
+        contacts += sim.stats.contacts;
+        floor    += sim.stats.floorContacts;
+        awake    += sim.stats.awakeBodies;
+        swept    += sim.stats.sweptBodies;
+        arena     = std::max(arena, sim.stats.arenaBytes);
+    }
+    double ns = msSince(start) * 1e6;
+
+    const double ticks = static_cast<double>(opt.ticks);
+    std::printf("%10zu %12.3f %12.2f %14.0f %14.0f %14.0f %12.0f %12.1f %10zu %8llu\n",
+                n,
+                ns / ticks * 1e-6,
+                ns / (ticks * static_cast<double>(n)),
+                static_cast<double>(pairs) / ticks,
+                static_cast<double>(contacts) / ticks,
+                static_cast<double>(floor) / ticks,
+                static_cast<double>(awake) / ticks,
+                static_cast<double>(swept) / ticks,
+                arena >> 10,
+                static_cast<unsigned long long>(allocs));
+    std::fflush(stdout);
+}
+
+// ---------- rollback ----------
+
+static constexpr int kRewindTicks = 8;
+
+static bool sameBodies(const BodyStore& a, const BodyStore& b)
+{
+    std::vector<const std::vector<float>*> arrays;
+    a.forEachArray([&](const std::vector<float>& v) { arrays.push_back(&v); });
+    std::size_t k    = 0;
+    bool        same = true;
+    b.forEachArray([&](const std::vector<float>& v) {
+        same = same && std::memcmp(arrays[k++]->data(), v.data(), v.size() * sizeof(float)) == 0;
+    });
+    return same;
+}
+
+static void runRollback(SimState& sim, const BenchOptions& opt, float dt)
+{
+    const std::size_t n = sim.bodies.size();
+    RollbackRing      ring(kRewindTicks * 2, n);
+
+    // A push every tick keeps some of the scene from settling; an empty
+    // snapshot has nobody to push
+    auto push = [&](std::uint64_t tick) {
+        if (n == 0) return;
+        SimInput in{static_cast<std::uint32_t>(tick * 2654435761u % n), {0.0f, 400.0f, 0.0f}, {}};
+        ring.addInput(tick, in);
+    };
+
+    std::size_t saved = 0;
+    auto start = Clock::now();
+    for (int t = 0; t < opt.ticks; ++t) {
+        push(ring.currentTick());
+        ring.step(sim, dt);
+        saved += ring.lastSaveBytes();
+    }
+    const double stepMs = msSince(start) / opt.ticks;
+
+    const BodyStore     expected = sim.bodies;
+    const std::uint64_t from     = ring.currentTick() - kRewindTicks;
+
+    start = Clock::now();
+    ring.restore(from, sim);
+    const double restoreMs = msSince(start);
+
+    start = Clock::now();
+    const bool replayed = ring.resimulateFrom(from, sim, dt);
+    const double resimMs = msSince(start);
+
+    std::printf("%10zu %12.3f %12.0f %12.3f %12.3f %10s\n",
+                n, stepMs, static_cast<double>(saved) / opt.ticks / 1024.0, restoreMs, resimMs,
+                !replayed ? "evicted" : sameBodies(expected, sim.bodies) ? "exact" : "DIFFERS");
+    std::fflush(stdout);
+}
+
+int main(int argc, char* argv[])
+{
+    BenchOptions opt;
+    if (!parseArgs(argc, argv, opt)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const float dt = 1.0f / opt.hz;
+
+    if (opt.writeSnapshotPath) {
+        SimState sim;
+        spawnLattice(sim, opt.bodyCounts.front());
+        auto start = Clock::now();
+        if (!writeSnapshot(opt.writeSnapshotPath, sim)) return 1;
+        std::printf("wrote %zu bodies to %s in %.1f ms\n",
+                    sim.bodies.size(), opt.writeSnapshotPath, msSince(start));
+        return 0;
+    }
+
+    profilerSetThreadName("main");
+    profilerSetEnabled(opt.tracePath != nullptr);
+
+    ThreadPool pool(opt.threads);
+
+    auto newSim = [&](SimState& sim) {
+        sim.pool                       = &pool;
+        sim.params.velocityIterations  = opt.iterations;
+        sim.params.allowSleep          = opt.sleep;
+        sim.params.continuousCollision = opt.ccd;
+    };
+
+    // Load before the header so the timing line comes first
+    SimState   loaded;
+    MappedFile file;
+    if (opt.snapshotPath) {
+        auto         start = Clock::now();
+        SnapshotView view;
+        if (!file.open(opt.snapshotPath) || !openSnapshot(file.data(), file.size(), view))
+            return 1;
+        double mapMs = msSince(start);
+        loadSnapshot(view, loaded);
+        std::printf("loaded %zu bodies from %s in %.2f ms (map %.2f ms)\n",
+                    loaded.bodies.size(), opt.snapshotPath, msSince(start), mapMs);
+        file.close();
+    }
+
+    std::printf("physics-bench: %d ticks/run at %g Hz, %u threads, %d solver iterations,"
+                " sleep %s, ccd %s\n\n",
+                opt.ticks, opt.hz, pool.threadCount(), opt.iterations,
+                opt.sleep ? "on" : "off", opt.ccd ? "on" : "off");
+    if (opt.rollback) {
+        std::printf("%10s %12s %12s %12s %12s %10s\n",
+                    "bodies", "ms/tick", "saved KiB", "restore ms", "resim-8 ms", "replay");
+    } else {
+        std::printf("%10s %12s %12s %14s %14s %14s %12s %12s %10s %8s\n",
+                    "bodies", "ms/tick", "ns/body/tick", "tested/tick", "contacts/tick", "floor/tick",
+                    "awake/tick", "swept/tick", "arena KiB", "allocs");
+    }
+
+    auto run = opt.rollback ? runRollback : runTicks;
+    if (opt.snapshotPath) {
+        newSim(loaded);
+        run(loaded, opt, dt);
+    } else {
+        for (std::size_t n : opt.bodyCounts) {
+            SimState sim;
+            newSim(sim);
+            spawnLattice(sim, n);
+            run(sim, opt, dt);
+        }
+    }
+
+    if (opt.tracePath && !profilerWriteTrace(opt.tracePath))
+        return 1;
+    return 0;
+}
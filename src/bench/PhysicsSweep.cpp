@@ -0,0 +1,183 @@
+// Headless parameter sweep: one world per combination of the listed values,
+// all stepped in one process across every core.
+//
+//   physics-sweep [--bodies N] [--restitution R[,R...]] [--friction F[,F...]]
+//                 [--seeds S[,S...]] [--seconds T] [--hz H] [--threads T]
+//                 [--out FILE] [--snapshots DIR] [--trace FILE]
+//
+// Worlds are the jittered lattice from physics-bench, one per seed.
+// Results go to --out (default stdout) as CSV, one row per world: its
+// parameters, the time until every body first slept (-1 if it never did)
+// and the final kinetic and potential energy. --snapshots also writes each
+// world's final state as DIR/world-NNNN.snap (load with 3d-test --snapshot).
+
+#include "core/Profiler.h"
+#include "core/Snapshot.h"
+#include "core/ThreadPool.h"
+#include "core/WorldBatch.h"
+#include "Scenes.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+struct SweepOptions {
+    std::size_t                bodies{512};
+    std::vector<float>         restitution{SimParams{}.restitution};
+    std::vector<float>         friction{SimParams{}.friction};
+    std::vector<std::uint32_t> seeds{1234};
+    float                      seconds{30.0f};
+    float                      hz{60.0f};
+    unsigned                   threads{0};
+    const char*                outPath{nullptr};
+    const char*                snapshotDir{nullptr};
+    const char*                tracePath{nullptr};
+};
+
+static void usage(const char* argv0)
+{
+    std::fprintf(stderr,
+                 "usage: %s [--bodies N] [--restitution R[,R...]] [--friction F[,F...]]\n"
+                 "       [--seeds S[,S...]] [--seconds T] [--hz H] [--threads T]\n"
+                 "       [--out FILE] [--snapshots DIR] [--trace FILE]\n", argv0);
+}
+
+// "a,b,c" → {a, b, c}
+template <class T, class Parse>
+static std::vector<T> parseList(const char* text, Parse parse)
+{
+    std::vector<T> out;
+    std::string    list(text);
+    std::size_t    pos = 0;
+    while (pos < list.size()) {
+        std::size_t comma = list.find(',', pos);
+        if (comma == std::string::npos) comma = list.size();
+        out.push_back(static_cast<T>(parse(list.c_str() + pos)));
+        pos = comma + 1;
+    }
+    return out;
+}
+
+static bool parseArgs(int argc, char* argv[], SweepOptions& opt)
+{
+    auto toFloat = [](const char* s) { return std::strtod(s, nullptr); };
+    auto toUint  = [](const char* s) { return std::strtoul(s, nullptr, 10); };
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg  = argv[i];
+        const char* next = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(arg, "--bodies") == 0 && next) {
+            opt.bodies = std::strtoull(next, nullptr, 10);
+            ++i;
+        } else if (std::strcmp(arg, "--restitution") == 0 && next) {
+            opt.restitution = parseList<float>(next, toFloat);
+            ++i;
+        } else if (std::strcmp(arg, "--friction") == 0 && next) {
+            opt.friction = parseList<float>(next, toFloat);
+            ++i;
+        } else if (std::strcmp(arg, "--seeds") == 0 && next) {
+            opt.seeds = parseList<std::uint32_t>(next, toUint);
+            ++i;
+        } else if (std::strcmp(arg, "--seconds") == 0 && next) {
+            opt.seconds = static_cast<float>(std::atof(next));
+            ++i;
+        } else if (std::strcmp(arg, "--hz") == 0 && next) {
+            opt.hz = static_cast<float>(std::atof(next));
+            ++i;
+        } else if (std::strcmp(arg, "--threads") == 0 && next) {
+            opt.threads = static_cast<unsigned>(std::atoi(next));
+            ++i;
+        } else if (std::strcmp(arg, "--out") == 0 && next) {
+            opt.outPath = next;
+            ++i;
+        } else if (std::strcmp(arg, "--snapshots") == 0 && next) {
+            opt.snapshotDir = next;
+            ++i;
+        } else if (std::strcmp(arg, "--trace") == 0 && next) {
+            opt.tracePath = next;
+            ++i;
+        } else {
+            return false;
+        }
+    }
+    return opt.bodies > 0 && opt.seconds > 0.0f && opt.hz > 0.0f && !opt.restitution.empty()
+        && !opt.friction.empty() && !opt.seeds.empty();
+}
+
+// Parameters of world k; worlds are laid out restitution-major, seed-minor
+struct WorldConfig {
+    float         restitution;
+    float         friction;
+    std::uint32_t seed;
+};
+
+int main(int argc, char* argv[])
+{
+    SweepOptions opt;
+    if (!parseArgs(argc, argv, opt)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    profilerSetThreadName("main");
+    profilerSetEnabled(opt.tracePath != nullptr);
+
+    std::vector<WorldConfig> configs;
+    for (float r : opt.restitution)
+        for (float f : opt.friction)
+            for (std::uint32_t seed : opt.seeds)
+                configs.push_back({r, f, seed});
+
+    WorldBatch batch;
+    for (const WorldConfig& c : configs) {
+        SimState& sim = batch.add();
+        sim.params.restitution = c.restitution;
+        sim.params.friction    = c.friction;
+        spawnLattice(sim, opt.bodies, c.seed);
+    }
+
+    ThreadPool  pool(opt.threads);
+    const float dt    = 1.0f / opt.hz;
+    const int   ticks = static_cast<int>(opt.seconds * opt.hz + 0.5f);
+
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    batch.step(pool, dt, ticks);
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::fprintf(stderr, "physics-sweep: %zu worlds x %zu bodies x %d ticks on %u threads"
+                         " in %.2f s (%.0f world-ticks/s)\n",
+                 batch.size(), opt.bodies, ticks, pool.threadCount(), seconds,
+                 static_cast<double>(batch.size()) * ticks / seconds);
+
+    FILE* out = opt.outPath ? std::fopen(opt.outPath, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "physics-sweep: cannot write %s\n", opt.outPath);
+        return 1;
+    }
+    std::fprintf(out, "world,restitution,friction,seed,bodies,settle_s,kinetic_j,potential_j\n");
+    for (std::size_t w = 0; w < batch.size(); ++w) {
+        const WorldConfig& c = configs[w];
+        const WorldResult& r = batch.result(w);
+        std::fprintf(out, "%zu,%g,%g,%u,%zu,%.4f,%.6g,%.6g\n",
+                     w, c.restitution, c.friction, c.seed, batch.world(w).bodies.size(),
+                     r.settleTime, r.kineticEnergy, r.potentialEnergy);
+    }
+    if (out != stdout) std::fclose(out);
+
+    if (opt.snapshotDir) {
+        for (std::size_t w = 0; w < batch.size(); ++w) {
+            char path[4096];
+            std::snprintf(path, sizeof(path), "%s/world-%04zu.snap", opt.snapshotDir, w);
+            if (!writeSnapshot(path, batch.world(w))) return 1;
+        }
+    }
+
+    if (opt.tracePath && !profilerWriteTrace(opt.tracePath))
+        return 1;
+    return 0;
+}
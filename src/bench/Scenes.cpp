@@ -0,0 +1,29 @@
+#include "Scenes.h"
+#include "core/Physics.h"
+
+#include <cmath>
+#include <random>
+
+void spawnLattice(SimState& sim, std::size_t n, std::uint32_t seed)
+{
+    const float radius  = 0.5f;
+    const float mass    = 1.0f;
+    const float spacing = 2.0f * radius * 1.05f;
+    const auto  side    = static_cast<std::size_t>(std::ceil(std::cbrt(static_cast<double>(n))));
+    const float half    = 0.5f * static_cast<float>(side);
+
+    std::mt19937                          rng(seed);
+    std::uniform_real_distribution<float> jitter(-0.1f, 0.1f);
+
+    sim.bodies.clear();
+    sim.bodies.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto x = static_cast<float>(i % side);
+        const auto z = static_cast<float>((i / side) % side);
+        const auto y = static_cast<float>(i / (side * side));
+        glm::vec3 p{(x - half) * spacing + jitter(rng),
+                    radius + y * spacing,
+                    (z - half) * spacing + jitter(rng)};
+        sim.bodies.push_back(makeSphere(p, radius, mass));
+    }
+}
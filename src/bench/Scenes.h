@@ -0,0 +1,8 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "core/SimState.h"
+
+// Jittered lattice resting just above the floor: the bottom layer lands
+// immediately and the column above piles onto it. Same seed, same scene.
+void spawnLattice(SimState& sim, std::size_t n, std::uint32_t seed = 1234);
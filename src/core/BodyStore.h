@@ -0,0 +1,114 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "RigidBody.h"
+
+// Structure-of-arrays body storage: one contiguous float array per component,
+// so per-body kernels stream only the fields they touch and vectorize.
+// RigidBody remains the value type for spawning and single-body access.
+struct BodyStore {
+    std::vector<float> px, py, pz;     // position
+    std::vector<float> vx, vy, vz;     // linear velocity
+    std::vector<float> qw, qx, qy, qz; // orientation (w,x,y,z)
+    std::vector<float> wx, wy, wz;     // angular velocity
+    std::vector<float> fx, fy, fz;     // accumulated force
+    std::vector<float> tx, ty, tz;     // accumulated torque
+    std::vector<float> invMass;        // 1/kg; 0 = static
+    std::vector<float> invInertia;     // scalar; solid sphere: 5*invMass/(2*r²)
+    std::vector<float> radius;
+    std::vector<float> awake;          // 1 = simulated, 0 = asleep (float: usable as a mask)
+    std::vector<float> sleepTimer;     // seconds spent below the sleep thresholds
+
+    // Visits every component array (bulk resize / copy / serialize).
+    template <class F> void forEachArray(F&& f)
+    {
+        for (auto* a : {&px, &py, &pz, &vx, &vy, &vz, &qw, &qx, &qy, &qz,
+                        &wx, &wy, &wz, &fx, &fy, &fz, &tx, &ty, &tz,
+                        &invMass, &invInertia, &radius, &awake, &sleepTimer})
+            f(*a);
+    }
+    template <class F> void forEachArray(F&& f) const
+    {
+        for (auto* a : {&px, &py, &pz, &vx, &vy, &vz, &qw, &qx, &qy, &qz,
+                        &wx, &wy, &wz, &fx, &fy, &fz, &tx, &ty, &tz,
+                        &invMass, &invInertia, &radius, &awake, &sleepTimer})
+            f(*a);
+    }
+
+    std::size_t size()  const { return px.size(); }
+    bool        empty() const { return px.empty(); }
+
+    void reserve(std::size_t n) { forEachArray([n](auto& a) { a.reserve(n); }); }
+    void clear()                { forEachArray([](auto& a)  { a.clear(); }); }
+
+    void push_back(const RigidBody& b)
+    {
+        px.push_back(b.position.x); py.push_back(b.position.y); pz.push_back(b.position.z);
+        vx.push_back(b.velocity.x); vy.push_back(b.velocity.y); vz.push_back(b.velocity.z);
+        qw.push_back(b.orientation.w); qx.push_back(b.orientation.x);
+        qy.push_back(b.orientation.y); qz.push_back(b.orientation.z);
+        wx.push_back(b.angularVelocity.x); wy.push_back(b.angularVelocity.y);
+        wz.push_back(b.angularVelocity.z);
+        fx.push_back(b.accumForce.x);  fy.push_back(b.accumForce.y);  fz.push_back(b.accumForce.z);
+        tx.push_back(b.accumTorque.x); ty.push_back(b.accumTorque.y); tz.push_back(b.accumTorque.z);
+        invMass.push_back(b.invMass);
+        invInertia.push_back(b.invInertia);
+        radius.push_back(b.radius);
+        awake.push_back(b.awake ? 1.0f : 0.0f);
+        sleepTimer.push_back(b.sleepTimer);
+    }
+
+    RigidBody get(std::size_t i) const
+    {
+        RigidBody b;
+        b.position        = position(i);
+        b.velocity        = velocity(i);
+        b.orientation     = orientation(i);
+        b.angularVelocity = angularVelocity(i);
+        b.invMass         = invMass[i];
+        b.invInertia      = invInertia[i];
+        b.radius          = radius[i];
+        b.accumForce      = {fx[i], fy[i], fz[i]};
+        b.accumTorque     = {tx[i], ty[i], tz[i]};
+        b.awake           = awake[i] != 0.0f;
+        b.sleepTimer      = sleepTimer[i];
+        return b;
+    }
+
+    void set(std::size_t i, const RigidBody& b)
+    {
+        setPosition(i, b.position);
+        setVelocity(i, b.velocity);
+        setOrientation(i, b.orientation);
+        setAngularVelocity(i, b.angularVelocity);
+        invMass[i]    = b.invMass;
+        invInertia[i] = b.invInertia;
+        radius[i]     = b.radius;
+        fx[i] = b.accumForce.x;  fy[i] = b.accumForce.y;  fz[i] = b.accumForce.z;
+        tx[i] = b.accumTorque.x; ty[i] = b.accumTorque.y; tz[i] = b.accumTorque.z;
+        awake[i]      = b.awake ? 1.0f : 0.0f;
+        sleepTimer[i] = b.sleepTimer;
+    }
+
+    glm::vec3 position(std::size_t i)        const { return {px[i], py[i], pz[i]}; }
+    glm::vec3 velocity(std::size_t i)        const { return {vx[i], vy[i], vz[i]}; }
+    glm::quat orientation(std::size_t i)     const { return {qw[i], qx[i], qy[i], qz[i]}; }
+    glm::vec3 angularVelocity(std::size_t i) const { return {wx[i], wy[i], wz[i]}; }
+
+    void setPosition(std::size_t i, glm::vec3 p) { px[i] = p.x; py[i] = p.y; pz[i] = p.z; }
+    void setVelocity(std::size_t i, glm::vec3 v) { vx[i] = v.x; vy[i] = v.y; vz[i] = v.z; }
+    void setOrientation(std::size_t i, glm::quat q)
+    {
+        qw[i] = q.w; qx[i] = q.x; qy[i] = q.y; qz[i] = q.z;
+    }
+    void setAngularVelocity(std::size_t i, glm::vec3 w) { wx[i] = w.x; wy[i] = w.y; wz[i] = w.z; }
+
+    bool isAwake(std::size_t i) const { return awake[i] != 0.0f; }
+    void wake(std::size_t i) { awake[i] = 1.0f; sleepTimer[i] = 0.0f; }
+
+    // Forces wake the body; a sleeping body would otherwise ignore them
+    void applyForce (std::size_t i, glm::vec3 f) { fx[i] += f.x; fy[i] += f.y; fz[i] += f.z; wake(i); }
+    void applyTorque(std::size_t i, glm::vec3 t) { tx[i] += t.x; ty[i] += t.y; tz[i] += t.z; wake(i); }
+};
@@ -0,0 +1,217 @@
+#include "Broadphase.h"
+
+#include <algorithm>
+#include <cmath>
+
+// ---------- helpers ----------
+
+struct CellCoord {
+    int x, y, z;
+};
+
+static CellCoord cellOf(float x, float y, float z, float invCell)
+{
+    return { static_cast<int>(std::floor(x * invCell)),
+             static_cast<int>(std::floor(y * invCell)),
+             static_cast<int>(std::floor(z * invCell)) };
+}
+
+static std::uint32_t hashCell(int x, int y, int z, std::uint32_t mask)
+{
+    // Teschner et al. spatial hash primes
+    std::uint32_t h = (static_cast<std::uint32_t>(x) * 73856093u)
+                    ^ (static_cast<std::uint32_t>(y) * 19349663u)
+                    ^ (static_cast<std::uint32_t>(z) * 83492791u);
+    return h & mask;
+}
+
+static std::uint32_t tableSizeFor(std::size_t n)
+{
+    std::uint32_t size = 64;
+    while (size < 2 * n) size <<= 1;
+    return size;
+}
+
+// ---------- build ----------
+
+void Broadphase::buildGrid(const BodyStore& bodies, FrameArena& arena, float margin)
+{
+    const std::size_t n = bodies.size();
+
+    float maxR = 0.0f;
+    for (float r : bodies.radius) maxR = std::max(maxR, r);
+    cellSize = std::max(2.0f * maxR + margin, 1e-4f);
+
+    const std::uint32_t tableSize = tableSizeFor(n);
+    const float         invCell   = 1.0f / cellSize;
+    tableMask = tableSize - 1;
+
+    // Counting sort of bodies by cell hash
+    cellStart  = arena.alloc<std::uint32_t>(tableSize + 1);
+    bodyHash   = arena.alloc<std::uint32_t>(n);
+    cellBodies = arena.alloc<std::uint32_t>(n);
+    std::fill(cellStart.begin(), cellStart.end(), 0u);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        CellCoord c = cellOf(bodies.px[i], bodies.py[i], bodies.pz[i], invCell);
+        bodyHash[i] = hashCell(c.x, c.y, c.z, tableMask);
+        ++cellStart[bodyHash[i] + 1];
+    }
+    for (std::uint32_t h = 0; h < tableSize; ++h)
+        cellStart[h + 1] += cellStart[h];
+    for (std::size_t i = 0; i < n; ++i) {
+        // cellStart[h] doubles as the write cursor, shifted back below
+        cellBodies[cellStart[bodyHash[i]]++] = static_cast<std::uint32_t>(i);
+    }
+    for (std::uint32_t h = tableSize; h > 0; --h)
+        cellStart[h] = cellStart[h - 1];
+    cellStart[0] = 0;
+}
+
+std::size_t Broadphase::query(const BodyStore& bodies, std::size_t begin, std::size_t end,
+                              float margin, std::vector<BodyPair>& out,
+                              std::vector<BodyPair>& late) const
+{
+    const float invCell = 1.0f / cellSize;
+    std::size_t tested  = 0;
+
+    // Query the 27-cell neighbourhood of each awake body, keep j > i.
+    // Sleeping bodies don't query, so their pairs with a higher awake body
+    // are picked up from that side (j < i, j asleep) into `late`.
+    for (std::size_t i = begin; i < end; ++i) {
+        if (!bodies.isAwake(i)) continue;
+
+        const float     ax = bodies.px[i], ay = bodies.py[i], az = bodies.pz[i];
+        const float     ar = bodies.radius[i];
+        const CellCoord c  = cellOf(ax, ay, az, invCell);
+        const std::size_t first = out.size();
+
+        // Distinct neighbour cells can collide in the table; visit each slot once
+        std::uint32_t visited[27];
+        int           visitedCount = 0;
+
+        for (int oz = -1; oz <= 1; ++oz)
+        for (int oy = -1; oy <= 1; ++oy)
+        for (int ox = -1; ox <= 1; ++ox) {
+            std::uint32_t h = hashCell(c.x + ox, c.y + oy, c.z + oz, tableMask);
+            if (std::find(visited, visited + visitedCount, h) != visited + visitedCount)
+                continue;
+            visited[visitedCount++] = h;
+
+            for (std::uint32_t k = cellStart[h]; k < cellStart[h + 1]; ++k) {
+                std::uint32_t j = cellBodies[k];
+                if (j == i || (j < i && bodies.isAwake(j))) continue;
+                ++tested;
+
+                float dx    = bodies.px[j] - ax;
+                float dy    = bodies.py[j] - ay;
+                float dz    = bodies.pz[j] - az;
+                float reach = ar + bodies.radius[j] + margin;
+                if (dx * dx + dy * dy + dz * dz >= reach * reach) continue;
+
+                if (j > i) out.push_back({static_cast<std::uint32_t>(i), j});
+                else       late.push_back({j, static_cast<std::uint32_t>(i)});
+            }
+        }
+
+        // Restore brute-force order within this body's run
+        std::sort(out.begin() + static_cast<std::ptrdiff_t>(first), out.end(),
+                  [](const BodyPair& l, const BodyPair& r) { return l.b < r.b; });
+    }
+    return tested;
+}
+
+void Broadphase::build(const BodyStore& bodies, FrameArena& arena, float margin)
+{
+    ThreadPool inlinePool(1);
+    build(bodies, inlinePool, arena, margin);
+}
+
+void Broadphase::build(const BodyStore& bodies, ThreadPool& pool, FrameArena& arena, float margin)
+{
+    pairs       = {};
+    cellBodies  = {};
+    pairsTested = 0;
+    const std::size_t n = bodies.size();
+    if (n < 2) return;
+
+    buildGrid(bodies, arena, margin);
+
+    // Fixed-size chunks, each with its own output; concatenating them in
+    // chunk order gives exactly the serial result for any thread count.
+    constexpr std::size_t grain = 2048;
+    const std::size_t chunks = (n + grain - 1) / grain;
+    if (chunkPairs.size() < chunks) {
+        chunkPairs.resize(chunks);
+        chunkLate.resize(chunks);
+        chunkTested.resize(chunks);
+    }
+
+    pool.parallelFor(n, grain, [&](std::size_t begin, std::size_t end) {
+        std::vector<BodyPair>& out  = chunkPairs[begin / grain];
+        std::vector<BodyPair>& late = chunkLate[begin / grain];
+        out.clear();
+        late.clear();
+        chunkTested[begin / grain] = query(bodies, begin, end, margin, out, late);
+    });
+
+    std::size_t inOrder = 0, lateCount = 0;
+    for (std::size_t c = 0; c < chunks; ++c) {
+        inOrder     += chunkPairs[c].size();
+        lateCount   += chunkLate[c].size();
+        pairsTested += chunkTested[c];
+    }
+
+    pairs = arena.alloc<BodyPair>(inOrder + lateCount);
+    auto  at = pairs.begin();
+    for (std::size_t c = 0; c < chunks; ++c)
+        at = std::copy(chunkPairs[c].begin(), chunkPairs[c].end(), at);
+    if (lateCount == 0) return;
+
+    // Late pairs: gathered behind the in-order ones, sorted, then merged
+    // with them into a second array
+    for (std::size_t c = 0; c < chunks; ++c)
+        at = std::copy(chunkLate[c].begin(), chunkLate[c].end(), at);
+
+    auto byPair = [](const BodyPair& l, const BodyPair& r) {
+        return l.a != r.a ? l.a < r.a : l.b < r.b;
+    };
+    const auto mid = pairs.begin() + static_cast<std::ptrdiff_t>(inOrder);
+    std::sort(mid, pairs.end(), byPair);
+
+    std::span<BodyPair> merged = arena.alloc<BodyPair>(pairs.size());
+    std::merge(pairs.begin(), mid, mid, pairs.end(), merged.begin(), byPair);
+    pairs = merged;
+}
+
+// ---------- box query ----------
+
+void Broadphase::queryBox(const BodyStore& bodies, glm::vec3 lo, glm::vec3 hi,
+                          std::vector<std::uint32_t>& out, std::size_t maxCells) const
+{
+    out.clear();
+    const std::size_t n = bodies.size();
+    if (n == 0 || cellBodies.size() != n) return;
+
+    const float     invCell = 1.0f / cellSize;
+    const CellCoord c0      = cellOf(lo.x, lo.y, lo.z, invCell);
+    const CellCoord c1      = cellOf(hi.x, hi.y, hi.z, invCell);
+    const auto span = [](int a, int b) { return static_cast<std::size_t>(b - a) + 1; };
+
+    if (span(c0.x, c1.x) * span(c0.y, c1.y) * span(c0.z, c1.z) > maxCells) {
+        out.resize(n);
+        for (std::size_t i = 0; i < n; ++i) out[i] = static_cast<std::uint32_t>(i);
+        return;
+    }
+
+    // Distinct cells can share a slot; sort + unique drops the repeats
+    for (int z = c0.z; z <= c1.z; ++z)
+    for (int y = c0.y; y <= c1.y; ++y)
+    for (int x = c0.x; x <= c1.x; ++x) {
+        std::uint32_t h = hashCell(x, y, z, tableMask);
+        out.insert(out.end(), cellBodies.begin() + cellStart[h],
+                   cellBodies.begin() + cellStart[h + 1]);
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
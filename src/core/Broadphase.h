@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+#include "BodyStore.h"
+#include "FrameArena.h"
+#include "ThreadPool.h"
+
+// Candidate pair for the narrowphase; always a < b.
+struct BodyPair {
+    std::uint32_t a;
+    std::uint32_t b;
+};
+
+// Uniform-grid spatial hash, rebuilt every tick.
+// Cell edge = largest body diameter (+ margin), so any two overlapping
+// spheres sit in the same or adjacent cells → 27-cell neighbourhood query.
+// Pairs come out sorted by (a, b): same resolve order as the O(N²) loop.
+// Only awake bodies query; pairs where both bodies sleep are never reported.
+// Grid and pairs live in the tick's FrameArena; the per-chunk query output
+// is kept between builds, so neither allocates once warmed up.
+struct Broadphase {
+    float         cellSize{1.0f};
+    std::uint32_t tableMask{0};
+
+    std::span<std::uint32_t> cellStart;   // tableSize + 1 offsets into cellBodies
+    std::span<std::uint32_t> cellBodies;  // body indices grouped by cell hash
+    std::span<std::uint32_t> bodyHash;    // per body: hashed cell slot
+    std::span<BodyPair>      pairs;       // output of build()
+    std::size_t              pairsTested{0};  // distance tests run by build()
+
+    // Per chunk; awake body i meeting sleeping j < i is found out of (a, b)
+    // order, goes to chunkLate and is merged in after
+    std::vector<std::vector<BodyPair>> chunkPairs;
+    std::vector<std::vector<BodyPair>> chunkLate;
+    std::vector<std::size_t>           chunkTested;
+
+    // margin > 0 also reports pairs closer than ra + rb + margin.
+    void build(const BodyStore& bodies, FrameArena& arena, float margin = 0.0f);
+
+    // Neighbourhood queries split across the pool; same pairs, same order.
+    void build(const BodyStore& bodies, ThreadPool& pool, FrameArena& arena,
+               float margin = 0.0f);
+
+    // Bodies whose cell (as of the last build) overlaps the box, ascending,
+    // each once. Boxes spanning more than maxCells cells return every body.
+    void queryBox(const BodyStore& bodies, glm::vec3 lo, glm::vec3 hi,
+                  std::vector<std::uint32_t>& out, std::size_t maxCells = 4096) const;
+
+private:
+    void buildGrid(const BodyStore& bodies, FrameArena& arena, float margin);
+    std::size_t query(const BodyStore& bodies, std::size_t begin, std::size_t end,
+                      float margin, std::vector<BodyPair>& out,
+                      std::vector<BodyPair>& late) const;
+};
@@ -0,0 +1,37 @@
+#include "ContactBatches.h"
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+
+void ContactBatches::build(std::span<const Contact> contacts, std::size_t bodyCount,
+                           FrameArena& arena)
+{
+    bodyColors = arena.alloc<std::uint64_t>(bodyCount);
+    color      = arena.alloc<std::uint8_t>(contacts.size());
+    std::fill(bodyColors.begin(), bodyColors.end(), 0);
+    std::fill(std::begin(batchStart), std::end(batchStart), 0u);
+
+    for (std::size_t k = 0; k < contacts.size(); ++k) {
+        const Contact& c    = contacts[k];
+        std::uint64_t  used = bodyColors[c.a] | bodyColors[c.b];
+        std::uint32_t  col  = kMaxColors;
+        if (used != ~std::uint64_t{0}) {
+            col = static_cast<std::uint32_t>(std::countr_one(used));
+            bodyColors[c.a] |= std::uint64_t{1} << col;
+            bodyColors[c.b] |= std::uint64_t{1} << col;
+        }
+        color[k] = static_cast<std::uint8_t>(col);
+        ++batchStart[col + 1];
+    }
+
+    // Counting sort by colour, stable → contact order kept within a batch
+    for (std::uint32_t c = 0; c <= kMaxColors; ++c)
+        batchStart[c + 1] += batchStart[c];
+
+    order = arena.alloc<std::uint32_t>(contacts.size());
+    std::uint32_t cursor[kMaxColors + 1];
+    std::copy(batchStart, batchStart + kMaxColors + 1, cursor);
+    for (std::size_t k = 0; k < contacts.size(); ++k)
+        order[cursor[color[k]]++] = static_cast<std::uint32_t>(k);
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include "FrameArena.h"
+#include "Narrowphase.h"
+
+// Contacts partitioned by greedy graph colouring: no two contacts in the same
+// colour share a body, so each colour can be solved in parallel without races.
+// Colours run in order; a contact's colour is the lowest one free on both
+// bodies, so the partition doesn't depend on the thread count.
+// Per-body and per-contact arrays come from the tick's FrameArena.
+struct ContactBatches {
+    static constexpr std::uint32_t kMaxColors = 64;  // one bit per colour
+
+    std::span<std::uint64_t> bodyColors;  // per body: colours already used
+    std::span<std::uint8_t>  color;       // per contact; kMaxColors = overflow
+    std::span<std::uint32_t> order;       // contact indices grouped by colour
+    std::uint32_t            batchStart[kMaxColors + 2]{};  // offsets into order
+
+    void build(std::span<const Contact> contacts, std::size_t bodyCount, FrameArena& arena);
+
+    // Batch kMaxColors holds contacts on bodies with 64+ neighbours; solve it serially
+    std::uint32_t        batchCount() const { return kMaxColors + 1; }
+    const std::uint32_t* batch(std::uint32_t c) const { return order.data() + batchStart[c]; }
+    std::size_t          batchSize(std::uint32_t c) const { return batchStart[c + 1] - batchStart[c]; }
+};
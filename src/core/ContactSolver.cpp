@@ -0,0 +1,338 @@
+#include "ContactSolver.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr float kPositionSlop     = 0.005f;  // allowed sphere-sphere overlap
+constexpr float kPositionFraction = 0.8f;    // share of the remainder removed per tick
+
+constexpr std::uint32_t kFloorKey = 0xFFFFFFFFu;
+
+std::uint64_t pairKey(std::uint32_t a, std::uint32_t b)
+{
+    return (std::uint64_t{a} << 32) | b;
+}
+
+// Sorted merge: cursor advances monotonically through the cache
+const CachedImpulse* findCached(const std::vector<CachedImpulse>& cache, std::size_t& cursor,
+                                std::uint64_t key)
+{
+    while (cursor < cache.size() && cache[cursor].key < key) ++cursor;
+    if (cursor < cache.size() && cache[cursor].key == key) return &cache[cursor];
+    return nullptr;
+}
+
+// ---------- impulse application ----------
+
+void applyFloorImpulse(BodyStore& s, const FloorConstraint& c,
+                       float jn, float jtx, float jtz)
+{
+    const std::uint32_t i = c.body;
+    const float im = s.invMass[i];
+    const float ii = s.invInertia[i];
+    const float r  = s.radius[i];
+
+    s.vx[i] += jtx * im;
+    s.vy[i] += jn  * im;
+    s.vz[i] += jtz * im;
+    // r × (jtx, 0, jtz) with r = (0, -radius, 0)
+    s.wx[i] += -r * jtz * ii;
+    s.wz[i] +=  r * jtx * ii;
+}
+
+// P = n·jn + jt on B, -P on A; r × P = -radius·(n × jt) for both
+void applySphereImpulse(BodyStore& s, const SphereConstraint& c,
+                        float jn, float jtx, float jty, float jtz)
+{
+    const std::uint32_t a = c.a, b = c.b;
+    const float px = c.nx * jn + jtx;
+    const float py = c.ny * jn + jty;
+    const float pz = c.nz * jn + jtz;
+    const float ia = c.invMassA;
+    const float ib = c.invMassB;
+    s.vx[a] -= px * ia; s.vy[a] -= py * ia; s.vz[a] -= pz * ia;
+    s.vx[b] += px * ib; s.vy[b] += py * ib; s.vz[b] += pz * ib;
+
+    const float cx = c.ny * jtz - c.nz * jty;
+    const float cy = c.nz * jtx - c.nx * jtz;
+    const float cz = c.nx * jty - c.ny * jtx;
+    const float ka = -s.radius[a] * c.invInertiaA;
+    const float kb = -s.radius[b] * c.invInertiaB;
+    s.wx[a] += cx * ka; s.wy[a] += cy * ka; s.wz[a] += cz * ka;
+    s.wx[b] += cx * kb; s.wy[b] += cy * kb; s.wz[b] += cz * kb;
+}
+
+// Scale an accumulated tangent impulse back onto the friction cone
+void clampFriction(float& x, float& y, float& z, float maxT)
+{
+    float len = std::sqrt(x * x + y * y + z * z);
+    if (len > maxT) {
+        float k = len > 0.0f ? maxT / len : 0.0f;
+        x *= k; y *= k; z *= k;
+    }
+}
+
+// ---------- one velocity iteration per constraint ----------
+
+void solveFloor(BodyStore& s, FloorConstraint& c, float friction, float rollingFriction)
+{
+    const std::uint32_t i = c.body;
+    const float         r = s.radius[i];
+
+    // Normal: contact-point velocity along +Y is just vy (ω × r has no Y)
+    float jn     = c.effMassN * (c.bias - s.vy[i]);
+    float newAcc = std::max(c.impulse + jn, 0.0f);
+    jn        = newAcc - c.impulse;
+    c.impulse = newAcc;
+
+    // Friction: slip velocity at the contact point, v + ω × r
+    float slipX = s.vx[i] + s.wz[i] * r;
+    float slipZ = s.vz[i] - s.wx[i] * r;
+    float accX  = c.tangentX - c.effMassT * slipX;
+    float accZ  = c.tangentZ - c.effMassT * slipZ;
+
+    float accY = 0.0f;
+    clampFriction(accX, accY, accZ, friction * c.impulse);
+    float jtx = accX - c.tangentX;
+    float jtz = accZ - c.tangentZ;
+    c.tangentX = accX;
+    c.tangentZ = accZ;
+
+    applyFloorImpulse(s, c, jn, jtx, jtz);
+
+    // Rolling resistance: angular impulse opposing ω, at most
+    // rollingFriction · radius · normal impulse
+    const float ii = s.invInertia[i];
+    if (ii > 0.0f) {
+        float rx = c.rollX - s.wx[i] / ii;
+        float ry = c.rollY - s.wy[i] / ii;
+        float rz = c.rollZ - s.wz[i] / ii;
+        clampFriction(rx, ry, rz, rollingFriction * r * c.impulse);
+        s.wx[i] += (rx - c.rollX) * ii;
+        s.wy[i] += (ry - c.rollY) * ii;
+        s.wz[i] += (rz - c.rollZ) * ii;
+        c.rollX = rx; c.rollY = ry; c.rollZ = rz;
+    }
+}
+
+void solveSphere(BodyStore& s, SphereConstraint& c, float friction)
+{
+    const std::uint32_t a = c.a, b = c.b;
+
+    // Normal: ω × r is perpendicular to n for spheres, so linear terms only
+    float vRel = (s.vx[b] - s.vx[a]) * c.nx
+               + (s.vy[b] - s.vy[a]) * c.ny
+               + (s.vz[b] - s.vz[a]) * c.nz;
+
+    float jn     = c.effMass * (c.bias - vRel);
+    float newAcc = std::max(c.impulse + jn, 0.0f);
+    jn        = newAcc - c.impulse;
+    c.impulse = newAcc;
+    applySphereImpulse(s, c, jn, 0.0f, 0.0f, 0.0f);
+
+    // Friction: relative contact-point velocity, vB - rB·(ωB × n) - vA - rA·(ωA × n)
+    const float ra = s.radius[a], rb = s.radius[b];
+    const float wx = ra * s.wx[a] + rb * s.wx[b];
+    const float wy = ra * s.wy[a] + rb * s.wy[b];
+    const float wz = ra * s.wz[a] + rb * s.wz[b];
+    float dx = s.vx[b] - s.vx[a] - (wy * c.nz - wz * c.ny);
+    float dy = s.vy[b] - s.vy[a] - (wz * c.nx - wx * c.nz);
+    float dz = s.vz[b] - s.vz[a] - (wx * c.ny - wy * c.nx);
+    float dn = dx * c.nx + dy * c.ny + dz * c.nz;
+    dx -= c.nx * dn; dy -= c.ny * dn; dz -= c.nz * dn;
+
+    float accX = c.tangentX - c.effMassT * dx;
+    float accY = c.tangentY - c.effMassT * dy;
+    float accZ = c.tangentZ - c.effMassT * dz;
+    clampFriction(accX, accY, accZ, friction * c.impulse);
+
+    applySphereImpulse(s, c, 0.0f, accX - c.tangentX, accY - c.tangentY, accZ - c.tangentZ);
+    c.tangentX = accX;
+    c.tangentY = accY;
+    c.tangentZ = accZ;
+}
+
+// Overlap is re-measured along the contact normal: the solve has moved the
+// bodies since detection
+void correctSphere(BodyStore& s, const SphereConstraint& c)
+{
+    const float invA     = c.invMassA;
+    const float invB     = c.invMassB;
+    const float totalInv = invA + invB;
+    const float sep      = (s.px[c.b] - s.px[c.a]) * c.nx
+                         + (s.py[c.b] - s.py[c.a]) * c.ny
+                         + (s.pz[c.b] - s.pz[c.a]) * c.nz;
+    const float depth    = s.radius[c.a] + s.radius[c.b] - sep - kPositionSlop;
+    if (depth <= 0.0f || totalInv < 1e-8f) return;
+
+    float k  = kPositionFraction * depth / totalInv;
+    float ka = k * invA;
+    float kb = k * invB;
+    s.px[c.a] -= c.nx * ka; s.py[c.a] -= c.ny * ka; s.pz[c.a] -= c.nz * ka;
+    s.px[c.b] += c.nx * kb; s.py[c.b] += c.ny * kb; s.pz[c.b] += c.nz * kb;
+}
+
+} // namespace
+
+// ---------- solve ----------
+
+void ContactSolver::solve(BodyStore& s, std::span<const Contact> contacts,
+                          std::span<const std::uint32_t> floorContacts,
+                          const SimParams& params, float dt, ThreadPool& pool, FrameArena& arena)
+{
+    constexpr std::size_t grain = 512;
+
+    const float restitution = params.restitution;
+    const float threshold   = params.restitutionThreshold;
+    const float friction    = params.friction;
+
+    warmStarted = 0;
+
+    // Floor: build constraints, warm start from the cache
+    floors = arena.alloc<FloorConstraint>(floorContacts.size());
+    std::size_t cursor = 0;
+    for (std::size_t k = 0; k < floorContacts.size(); ++k) {
+        const std::uint32_t i = floorContacts[k];
+        const float         r = s.radius[i];
+
+        FloorConstraint& c = floors[k];
+        c.body     = i;
+        c.effMassN = s.invMass[i] > 0.0f ? 1.0f / s.invMass[i] : 0.0f;
+        c.effMassT = 1.0f / (s.invMass[i] + r * r * s.invInertia[i] + 1e-12f);
+        c.bias     = s.vy[i] < -threshold ? -restitution * s.vy[i] : 0.0f;
+        c.impulse  = 0.0f;
+        c.tangentX = c.tangentZ = 0.0f;
+        c.rollX = c.rollY = c.rollZ = 0.0f;
+
+        if (const CachedImpulse* hit = findCached(floorCache, cursor, pairKey(i, kFloorKey))) {
+            c.impulse  = hit->normal;
+            c.tangentX = hit->tangentX;
+            c.tangentZ = hit->tangentZ;
+            ++warmStarted;
+        }
+    }
+
+    // Spheres
+    spheres = arena.alloc<SphereConstraint>(contacts.size());
+    cursor = 0;
+    for (std::size_t k = 0; k < contacts.size(); ++k) {
+        const Contact&    ct = contacts[k];
+        SphereConstraint& c  = spheres[k];
+        c.a = ct.a; c.b = ct.b;
+        c.nx = ct.nx; c.ny = ct.ny; c.nz = ct.nz;
+        c.invMassA    = s.invMass[c.a]    * s.awake[c.a];
+        c.invMassB    = s.invMass[c.b]    * s.awake[c.b];
+        c.invInertiaA = s.invInertia[c.a] * s.awake[c.a];
+        c.invInertiaB = s.invInertia[c.b] * s.awake[c.b];
+
+        const float totalInv   = c.invMassA + c.invMassB;
+        const float ra = s.radius[c.a], rb = s.radius[c.b];
+        const float angularInv = ra * ra * c.invInertiaA + rb * rb * c.invInertiaB;
+        c.effMass     = totalInv > 1e-8f ? 1.0f / totalInv : 0.0f;
+        c.effMassT    = totalInv > 1e-8f ? 1.0f / (totalInv + angularInv) : 0.0f;
+        c.impulse     = 0.0f;
+        c.tangentX = c.tangentY = c.tangentZ = 0.0f;
+
+        float vRel = (s.vx[c.b] - s.vx[c.a]) * c.nx
+                   + (s.vy[c.b] - s.vy[c.a]) * c.ny
+                   + (s.vz[c.b] - s.vz[c.a]) * c.nz;
+        c.bias = vRel < -threshold ? -restitution * vRel : 0.0f;
+
+        if (const CachedImpulse* hit = findCached(sphereCache, cursor, pairKey(c.a, c.b))) {
+            // Friction is re-projected onto this tick's tangent plane
+            float tn   = hit->tangentX * c.nx + hit->tangentY * c.ny + hit->tangentZ * c.nz;
+            c.impulse  = hit->normal;
+            c.tangentX = hit->tangentX - c.nx * tn;
+            c.tangentY = hit->tangentY - c.ny * tn;
+            c.tangentZ = hit->tangentZ - c.nz * tn;
+            ++warmStarted;
+        }
+    }
+
+    batches.build(contacts, s.size(), arena);
+
+    // Runs fn(constraintIndex) over floors, then each colour; no two
+    // concurrent calls touch the same body.
+    auto forEachFloor = [&](auto&& fn) {
+        pool.parallelFor(floors.size(), grain, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t k = begin; k < end; ++k) fn(k);
+        });
+    };
+    auto forEachSphere = [&](auto&& fn) {
+        for (std::uint32_t col = 0; col < ContactBatches::kMaxColors; ++col) {
+            const std::uint32_t* batch = batches.batch(col);
+            pool.parallelFor(batches.batchSize(col), grain, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t k = begin; k < end; ++k) fn(batch[k]);
+            });
+        }
+        const std::uint32_t overflow = ContactBatches::kMaxColors;
+        const std::uint32_t* batch   = batches.batch(overflow);
+        for (std::size_t k = 0; k < batches.batchSize(overflow); ++k) fn(batch[k]);
+    };
+
+    // Velocities the integrator moved the bodies with
+    const std::size_t n = s.size();
+    vx0 = arena.alloc<float>(n);
+    vy0 = arena.alloc<float>(n);
+    vz0 = arena.alloc<float>(n);
+    pool.parallelFor(n, 4096, [&](std::size_t begin, std::size_t end) {
+        std::copy(s.vx.begin() + begin, s.vx.begin() + end, vx0.begin() + begin);
+        std::copy(s.vy.begin() + begin, s.vy.begin() + end, vy0.begin() + begin);
+        std::copy(s.vz.begin() + begin, s.vz.begin() + end, vz0.begin() + begin);
+    });
+
+    // Warm start: re-apply last tick's accumulated impulses
+    forEachFloor([&](std::size_t k) {
+        const FloorConstraint& c = floors[k];
+        applyFloorImpulse(s, c, c.impulse, c.tangentX, c.tangentZ);
+    });
+    forEachSphere([&](std::size_t k) {
+        const SphereConstraint& c = spheres[k];
+        applySphereImpulse(s, c, c.impulse, c.tangentX, c.tangentY, c.tangentZ);
+    });
+
+    // Velocity iterations
+    for (int it = 0; it < params.velocityIterations; ++it) {
+        forEachFloor([&](std::size_t k) { solveFloor(s, floors[k], friction, params.rollingFriction); });
+        forEachSphere([&](std::size_t k) { solveSphere(s, spheres[k], friction); });
+    }
+
+    // Positions were already advanced with the pre-solve velocities; shift
+    // them by the solver's change so the tick is solve-then-integrate and
+    // resting contacts don't sink g·dt² per tick.
+    pool.parallelFor(n, 4096, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            s.px[i] += (s.vx[i] - vx0[i]) * dt;
+            s.py[i] += (s.vy[i] - vy0[i]) * dt;
+            s.pz[i] += (s.vz[i] - vz0[i]) * dt;
+        }
+    });
+
+    // Residual overlap: sphere pairs by invMass share, then the floor wins
+    forEachSphere([&](std::size_t k) { correctSphere(s, spheres[k]); });
+    forEachFloor([&](std::size_t k) {
+        const std::uint32_t i = floors[k].body;
+        s.py[i] = std::max(s.py[i], params.floorY + s.radius[i]);
+    });
+
+    // Carry accumulated impulses to the next tick; both lists are key-sorted
+    floorCache.resize(floors.size());
+    for (std::size_t k = 0; k < floors.size(); ++k) {
+        const FloorConstraint& c = floors[k];
+        floorCache[k] = {pairKey(c.body, kFloorKey), c.impulse, c.tangentX, 0.0f, c.tangentZ};
+    }
+
+    sphereCache.resize(spheres.size());
+    for (std::size_t k = 0; k < spheres.size(); ++k) {
+        const SphereConstraint& c = spheres[k];
+        sphereCache[k] = {pairKey(c.a, c.b), c.impulse, c.tangentX, c.tangentY, c.tangentZ};
+    }
+}
+
+void ContactSolver::reset()
+{
+    sphereCache.clear();
+    floorCache.clear();
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "BodyStore.h"
+#include "ContactBatches.h"
+#include "FrameArena.h"
+#include "Narrowphase.h"
+#include "SimParams.h"
+#include "ThreadPool.h"
+
+// Accumulated impulse carried to the next tick, keyed by body pair
+struct CachedImpulse {
+    std::uint64_t key;
+    float         normal;
+    float         tangentX, tangentY, tangentZ;
+};
+
+// Sphere-sphere: normal impulse plus Coulomb friction in the tangent plane,
+// contact points at ±radius along the normal
+struct SphereConstraint {
+    std::uint32_t a, b;
+    float         nx, ny, nz;   // A → B
+    float         invMassA, invMassB;        // 0 for a sleeping body: held static
+    float         invInertiaA, invInertiaB;
+    float         effMass;      // 1 / (invMassA + invMassB)
+    float         effMassT;     // 1 / (invMassA + invMassB + rA²·invIA + rB²·invIB)
+    float         bias;         // target separating velocity (restitution)
+    float         impulse;      // accumulated, >= 0
+    float         tangentX, tangentY, tangentZ;  // accumulated friction on B
+};
+
+// Sphere-floor: +Y normal plus Coulomb friction in XZ at r = (0, -radius, 0),
+// and rolling resistance so rolling spheres eventually stop (and can sleep)
+struct FloorConstraint {
+    std::uint32_t body;
+    float         effMassN;     // 1 / invMass
+    float         effMassT;     // 1 / (invMass + radius²·invInertia)
+    float         bias;
+    float         impulse;
+    float         tangentX, tangentZ;
+    float         rollX, rollY, rollZ;  // angular impulse against spin (not cached)
+};
+
+// Iterative sequential-impulse solver.
+// Accumulated impulses are clamped (normal >= 0, |tangent| <= mu·normal) and
+// cached by body pair, so the next tick starts from last tick's answer
+// (warm starting) and resting stacks converge in a few iterations.
+// Iterations run floor contacts, then each colour batch, in parallel.
+// Constraints live in the tick's FrameArena; only the cache is kept.
+struct ContactSolver {
+    std::span<SphereConstraint>   spheres;
+    std::span<FloorConstraint>    floors;
+    ContactBatches                batches;
+
+    std::vector<CachedImpulse>    sphereCache;  // last tick, sorted by key; rewritten
+    std::vector<CachedImpulse>    floorCache;   // in place once constraints are built
+    std::span<float>              vx0, vy0, vz0;  // pre-solve velocities
+
+    std::size_t                   warmStarted{0};  // constraints found in the cache
+
+    // Runs after integrateAll(): contacts sorted by (a, b), floorContacts
+    // ascending — as the broadphase/narrowphase produce them.
+    void solve(BodyStore& bodies, std::span<const Contact> contacts,
+               std::span<const std::uint32_t> floorContacts,
+               const SimParams& params, float dt, ThreadPool& pool, FrameArena& arena);
+
+    // Drop cached impulses (bodies were added, removed or teleported)
+    void reset();
+};
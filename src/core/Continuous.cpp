@@ -0,0 +1,168 @@
+#include "Continuous.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Clamped bodies stop this far inside first contact: enough for the
+// narrowphase to report the pair, well inside the solver's position slop.
+constexpr float kTouchDepth = 0.002f;
+
+struct Sweep {
+    float         toi{1.0f};
+    std::uint32_t other{kSweepFloor};
+};
+
+// Earliest t in [0, 1) at which a sphere moving from + motion·t comes within
+// reach of the sphere at c. Spheres already that close, or moving apart,
+// are left to the discrete narrowphase.
+float sweepSphere(glm::vec3 from, glm::vec3 motion, glm::vec3 c, float reach)
+{
+    const glm::vec3 m = from - c;
+    const float     a = glm::dot(motion, motion);
+    const float     b = glm::dot(m, motion);
+    const float     k = glm::dot(m, m) - reach * reach;
+    if (k <= 0.0f || b >= 0.0f || a < 1e-12f) return 1.0f;
+
+    const float disc = b * b - a * k;
+    if (disc < 0.0f) return 1.0f;
+    return std::min((-b - std::sqrt(disc)) / a, 1.0f);
+}
+
+// First impact of body i, moving from + motion over the tick, against the
+// floor and `nearby`. Other fast bodies are swept relative to i, from their
+// own start-of-tick positions; the rest are held where they are.
+Sweep sweepBody(const BodyStore& s, std::uint32_t i, glm::vec3 from, glm::vec3 motion,
+                const std::vector<std::uint32_t>& nearby, std::span<const std::uint32_t> fast,
+                float floorY, float dt)
+{
+    const float r = s.radius[i];
+    Sweep       best;
+
+    const float bottom = from.y - r;
+    if (motion.y < 0.0f && bottom >= floorY)
+        best.toi = std::min((bottom - floorY + kTouchDepth) / -motion.y, 1.0f);
+
+    for (std::uint32_t j : nearby) {
+        if (j == i) continue;
+        const glm::vec3 pj(s.px[j], s.py[j], s.pz[j]);
+        const float     reach = r + s.radius[j] - kTouchDepth;
+
+        float t;
+        if (std::binary_search(fast.begin(), fast.end(), j)) {
+            const glm::vec3 mj = glm::vec3(s.vx[j], s.vy[j], s.vz[j]) * dt;
+            t = sweepSphere(from - (pj - mj), motion - mj, glm::vec3(0.0f), reach);
+        } else {
+            t = sweepSphere(from, motion, pj, reach);
+        }
+        if (t < best.toi) best = {t, j};
+    }
+    return best;
+}
+
+// Candidates around the swept path. cellSize ≥ twice the largest radius,
+// which also covers neighbours that moved a little since the grid was built.
+void gatherNearby(const BodyStore& s, const Broadphase& bp, std::uint32_t i,
+                  glm::vec3 from, glm::vec3 to, std::vector<std::uint32_t>& out)
+{
+    const glm::vec3 pad(s.radius[i] + bp.cellSize);
+    bp.queryBox(s, glm::min(from, to) - pad, glm::max(from, to) + pad, out);
+}
+
+} // namespace
+
+// ---------- clamp ----------
+
+void ContinuousCollision::clamp(BodyStore& s, Broadphase& bp, const SimParams& params, float dt,
+                                FrameArena& arena)
+{
+    fast = {};
+    hits = {};
+    if (!params.continuousCollision) return;
+
+    const float threshold = params.ccdMotionThreshold;
+    std::size_t count     = 0;
+    fast = arena.alloc<std::uint32_t>(s.size());
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        const float v2    = s.vx[i] * s.vx[i] + s.vy[i] * s.vy[i] + s.vz[i] * s.vz[i];
+        const float limit = threshold * s.radius[i];
+        if (s.invMass[i] != 0.0f && s.isAwake(i) && v2 * dt * dt > limit * limit)
+            fast[count++] = static_cast<std::uint32_t>(i);
+    }
+    fast = arena.trim(fast, count);
+    if (fast.empty()) return;
+
+    // Sweep everything against positions as integrated, then move: the
+    // result doesn't depend on the order the bodies are visited in
+    count = 0;
+    hits  = arena.alloc<SweepHit>(fast.size());
+    for (std::uint32_t i : fast) {
+        const glm::vec3 motion = glm::vec3(s.vx[i], s.vy[i], s.vz[i]) * dt;
+        const glm::vec3 to(s.px[i], s.py[i], s.pz[i]);
+        const glm::vec3 from = to - motion;
+
+        gatherNearby(s, bp, i, from, to, nearby);
+        const Sweep hit = sweepBody(s, i, from, motion, nearby, fast, params.floorY, dt);
+        if (hit.toi < 1.0f)
+            hits[count++] = {i, hit.other, hit.toi, s.vx[i], s.vy[i], s.vz[i]};
+    }
+    hits = arena.trim(hits, count);
+
+    count = 0;
+    std::span<BodyPair> newPairs = arena.alloc<BodyPair>(hits.size());
+    for (const SweepHit& h : hits) {
+        const std::uint32_t i = h.body;
+        const float         back = 1.0f - h.toi;
+        s.px[i] -= h.vx0 * dt * back;
+        s.py[i] -= h.vy0 * dt * back;
+        s.pz[i] -= h.vz0 * dt * back;
+        if (h.other != kSweepFloor)
+            newPairs[count++] = {std::min(i, h.other), std::max(i, h.other)};
+    }
+    newPairs = arena.trim(newPairs, count);
+    if (newPairs.empty()) return;
+
+    // Make sure the narrowphase tests each pair at the impact position
+    auto byPair = [](const BodyPair& l, const BodyPair& r) {
+        return l.a != r.a ? l.a < r.a : l.b < r.b;
+    };
+    std::sort(newPairs.begin(), newPairs.end(), byPair);
+    auto last = std::unique(newPairs.begin(), newPairs.end(),
+                            [](const BodyPair& l, const BodyPair& r) {
+                                return l.a == r.a && l.b == r.b;
+                            });
+
+    std::span<BodyPair> merged = arena.alloc<BodyPair>(bp.pairs.size() + newPairs.size());
+    auto end = std::set_union(bp.pairs.begin(), bp.pairs.end(), newPairs.begin(), last,
+                              merged.begin(), byPair);
+    bp.pairs = arena.trim(merged, static_cast<std::size_t>(end - merged.begin()));
+}
+
+// ---------- advance ----------
+
+void ContinuousCollision::advance(BodyStore& s, const Broadphase& bp, const SimParams& params,
+                                  float dt)
+{
+    for (const SweepHit& h : hits) {
+        const std::uint32_t i = h.body;
+        const glm::vec3     v(s.vx[i], s.vy[i], s.vz[i]);
+
+        // The solver shifted positions by (v - v0)·dt as if the body had
+        // moved for the whole tick; take that back and move for what's left
+        const glm::vec3 from(s.px[i] - (v.x - h.vx0) * dt,
+                             s.py[i] - (v.y - h.vy0) * dt,
+                             s.pz[i] - (v.z - h.vz0) * dt);
+        const glm::vec3 motion = v * ((1.0f - h.toi) * dt);
+
+        // Everything else has finished the tick; hold it in place
+        gatherNearby(s, bp, i, from, from + motion, nearby);
+        const Sweep next = sweepBody(s, i, from, motion, nearby, {}, params.floorY, dt);
+
+        // A second impact stops the body there; next tick's contacts resolve it
+        const glm::vec3 p = from + motion * next.toi;
+        s.px[i] = p.x;
+        s.py[i] = std::max(p.y, params.floorY + s.radius[i]);
+        s.pz[i] = p.z;
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "BodyStore.h"
+#include "Broadphase.h"
+#include "FrameArena.h"
+#include "SimParams.h"
+
+// A fast body's first impact this tick
+struct SweepHit {
+    std::uint32_t body;
+    std::uint32_t other;       // kSweepFloor for the floor plane
+    float         toi;         // fraction of the tick spent before the impact
+    float         vx0, vy0, vz0;  // velocity the solver started from
+};
+
+constexpr std::uint32_t kSweepFloor = 0xFFFFFFFFu;
+
+// Swept-sphere continuous collision, so the tick can be longer than the
+// time a body takes to cross another one.
+//
+// Only bodies moving more than ccdMotionThreshold · radius in one tick are
+// swept; everything else stays with the discrete narrowphase. Each fast body
+// is swept from its start-of-tick position (p - v·dt) against the floor and
+// its grid neighbours: slow ones held where they ended the tick (their own
+// motion is below the threshold), fast ones swept alongside it. A hit pulls
+// the body back to just inside first contact, so the narrowphase and solver
+// see the real impact instead of a tunnelled or deep overlap; advance() then
+// spends the rest of the tick along the post-impact velocity, for those
+// bodies only.
+struct ContinuousCollision {
+    std::span<std::uint32_t>   fast;    // this tick's swept bodies, ascending (arena)
+    std::span<SweepHit>        hits;    // bodies pulled back, ascending (arena)
+    std::vector<std::uint32_t> nearby;  // Broadphase::queryBox output, kept
+
+    // After broadphase.build(): clamps fast bodies to their time of impact
+    // and adds each sphere hit to broadphase.pairs (kept sorted).
+    void clamp(BodyStore& bodies, Broadphase& broadphase, const SimParams& params, float dt,
+               FrameArena& arena);
+
+    // After the solve: moves each clamped body for the remaining
+    // (1 - toi)·dt, stopping at the next impact if there is one.
+    void advance(BodyStore& bodies, const Broadphase& broadphase, const SimParams& params,
+                 float dt);
+};
@@ -0,0 +1,76 @@
+#include "Culling.h"
+
+// ---------- frustum ----------
+
+Frustum extractFrustum(const glm::mat4& m)
+{
+    // Row i of m is (m[0][i], m[1][i], m[2][i], m[3][i]) — glm is column-major
+    const glm::vec4 row0{m[0][0], m[1][0], m[2][0], m[3][0]};
+    const glm::vec4 row1{m[0][1], m[1][1], m[2][1], m[3][1]};
+    const glm::vec4 row2{m[0][2], m[1][2], m[2][2], m[3][2]};
+    const glm::vec4 row3{m[0][3], m[1][3], m[2][3], m[3][3]};
+
+    const glm::vec4 planes[6] = {
+        row3 + row0, row3 - row0,   // left, right
+        row3 + row1, row3 - row1,   // bottom, top
+        row3 + row2, row3 - row2,   // near, far
+    };
+
+    Frustum f{};
+    for (int k = 0; k < 6; ++k) {
+        const float inv = 1.0f / glm::length(glm::vec3(planes[k]));
+        f.nx[k] = planes[k].x * inv;
+        f.ny[k] = planes[k].y * inv;
+        f.nz[k] = planes[k].z * inv;
+        f.d[k]  = planes[k].w * inv;
+    }
+    return f;
+}
+
+// ---------- cull + bucket ----------
+
+void cullSpheres(const float* px, const float* py, const float* pz, const float* r,
+                 std::size_t n, const Frustum& f, const glm::vec3& eye,
+                 const LodParams& lod, CullResult& out)
+{
+    out.level.resize(n);
+    std::uint8_t* level = out.level.data();
+
+    const float t0 = lod.lodDistance[0] * lod.lodDistance[0];
+    const float t1 = lod.lodDistance[1] * lod.lodDistance[1];
+    const float t2 = lod.lodDistance[2] * lod.lodDistance[2];
+
+    // Pass 1: branch-free per body, so the compiler can vectorize it
+    for (std::size_t i = 0; i < n; ++i) {
+        const float x = px[i], y = py[i], z = pz[i], rad = r[i];
+
+        float minDist = f.nx[0] * x + f.ny[0] * y + f.nz[0] * z + f.d[0];
+        for (int k = 1; k < 6; ++k) {
+            const float dist = f.nx[k] * x + f.ny[k] * y + f.nz[k] * z + f.d[k];
+            minDist = dist < minDist ? dist : minDist;
+        }
+
+        const float dx = x - eye.x, dy = y - eye.y, dz = z - eye.z;
+        const float dist2      = dx * dx + dy * dy + dz * dz;
+        const float r2         = rad * rad;
+        const int   k          = (dist2 >= t0 * r2) + (dist2 >= t1 * r2) + (dist2 >= t2 * r2);
+        const int   culledMask = -static_cast<int>(minDist < -rad);  // all ones when culled
+
+        level[i] = static_cast<std::uint8_t>(k | culledMask);
+    }
+
+    // Pass 2: counting sort into level buckets
+    std::array<std::uint32_t, kLodLevels> counts{};
+    for (std::size_t i = 0; i < n; ++i)
+        if (level[i] != kCulled) ++counts[level[i]];
+
+    out.first[0] = 0;
+    for (int k = 0; k < kLodLevels; ++k)
+        out.first[k + 1] = out.first[k] + counts[k];
+
+    out.order.resize(out.first[kLodLevels]);
+    std::array<std::uint32_t, kLodLevels> cursor{};
+    for (int k = 0; k < kLodLevels; ++k) cursor[k] = out.first[k];
+    for (std::size_t i = 0; i < n; ++i)
+        if (level[i] != kCulled) out.order[cursor[level[i]]++] = static_cast<std::uint32_t>(i);
+}
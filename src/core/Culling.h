@@ -0,0 +1,43 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// CPU view-frustum culling + distance LOD for body bounding spheres.
+// No GL here: the renderer draws each bucket with its own sphere mesh.
+
+constexpr int          kLodLevels = 4;      // 0 = finest
+constexpr std::uint8_t kCulled    = 0xFF;
+
+// Six normalized planes (left, right, bottom, top, near, far), SoA so the
+// per-body test is one straight-line loop; inside is nx*x + ny*y + nz*z + d >= 0
+struct Frustum {
+    float nx[6], ny[6], nz[6], d[6];
+};
+
+// Gribb-Hartmann extraction from projection * view (GL clip space, z in [-1, 1])
+Frustum extractFrustum(const glm::mat4& viewProj);
+
+// Distance thresholds in body radii: a body at distance < lodDistance[k] * radius
+// uses level k, beyond the last one the coarsest level
+struct LodParams {
+    float lodDistance[kLodLevels - 1]{20.0f, 60.0f, 160.0f};
+};
+
+struct CullResult {
+    std::vector<std::uint8_t>  level;   // per body: 0..kLodLevels-1 or kCulled
+    std::vector<std::uint32_t> order;   // visible bodies grouped by level, ascending index within each
+    std::array<std::uint32_t, kLodLevels + 1> first{};  // level k is order[first[k] .. first[k+1])
+
+    std::uint32_t visible() const { return first[kLodLevels]; }
+    std::uint32_t count(int k) const { return first[k + 1] - first[k]; }
+};
+
+// Tests n bounding spheres (SoA centres + radii, e.g. BodyStore or a
+// RenderState), then buckets the survivors by level.
+// Buffers in `out` keep their capacity across frames.
+void cullSpheres(const float* px, const float* py, const float* pz, const float* radius,
+                 std::size_t n, const Frustum& frustum, const glm::vec3& eye,
+                 const LodParams& lod, CullResult& out);
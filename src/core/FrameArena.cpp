@@ -0,0 +1,79 @@
+#include "FrameArena.h"
+
+#include <new>
+
+static std::size_t alignUp(std::size_t n, std::size_t a)
+{
+    return (n + a - 1) / a * a;
+}
+
+static unsigned char* allocateBlock(std::size_t bytes)
+{
+    return static_cast<unsigned char*>(
+        ::operator new(bytes, std::align_val_t{FrameArena::kAlignment}));
+}
+
+static void freeBlock(void* p)
+{
+    ::operator delete(p, std::align_val_t{FrameArena::kAlignment});
+}
+
+FrameArena::FrameArena(std::size_t initialBytes)
+{
+    if (initialBytes > 0) {
+        m_capacity = alignUp(initialBytes, kAlignment);
+        m_block    = allocateBlock(m_capacity);
+    }
+}
+
+FrameArena::~FrameArena()
+{
+    for (void* p : m_overflow) freeBlock(p);
+    if (m_block) freeBlock(m_block);
+}
+
+void* FrameArena::allocate(std::size_t bytes)
+{
+    bytes   = alignUp(bytes > 0 ? bytes : 1, kAlignment);
+    m_used += bytes;
+    if (m_used > m_peak) m_peak = m_used;
+
+    if (m_top + bytes <= m_capacity) {
+        void* p = m_block + m_top;
+        m_top  += bytes;
+        return p;
+    }
+
+    // Out of block: heap for the rest of this tick, regrow at reset()
+    m_overflow.push_back(allocateBlock(bytes));
+    return m_overflow.back();
+}
+
+void FrameArena::release(unsigned char* from, unsigned char* to)
+{
+    // Only the top of the block can be handed back; allocate() padded its
+    // end out to kAlignment, so compare the padded end
+    if (!m_block || from > to || from < m_block || to > m_block + m_top) return;
+    if (alignUp(static_cast<std::size_t>(to - m_block), kAlignment) != m_top) return;
+    const std::size_t start = alignUp(static_cast<std::size_t>(from - m_block), kAlignment);
+    if (start >= m_top) return;
+    m_used -= m_top - start;
+    m_top   = start;
+}
+
+void FrameArena::reset()
+{
+    if (!m_overflow.empty()) {
+        for (void* p : m_overflow) freeBlock(p);
+        m_overflow.clear();
+
+        // Sized from the high-water mark with headroom, so slow growth
+        // (a scene settling into more contacts) doesn't regrow every tick
+        if (m_block) freeBlock(m_block);
+        m_capacity = alignUp(m_peak + m_peak / 2, std::size_t{64} << 10);
+        m_block    = allocateBlock(m_capacity);
+        ++m_growths;
+    }
+    m_top  = 0;
+    m_used = 0;
+}
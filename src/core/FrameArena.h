@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// Linear allocator for data that lives for one physics tick: grid, pairs,
+// contacts, constraints. Allocation bumps a pointer; reset() rewinds it.
+//
+// When a tick needs more than the block holds, the extra comes from the
+// heap and reset() replaces the block with one sized from that tick's
+// high-water mark (plus headroom). Steady state is one block, no heap
+// traffic, and reset() is O(1).
+class FrameArena {
+public:
+    static constexpr std::size_t kAlignment = 64;  // every allocation starts a cache line
+
+    explicit FrameArena(std::size_t initialBytes = 0);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&)            = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(std::size_t bytes);
+
+    // Uninitialized storage for `count` Ts, valid until reset()
+    template <class T>
+    std::span<T> alloc(std::size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "arena memory is never destroyed");
+        return {static_cast<T*>(allocate(count * sizeof(T))), count};
+    }
+
+    // Shrinks the most recent allocation to its first `count` elements and
+    // returns them; the tail goes back to the arena. Anything older is just
+    // narrowed
+    template <class T>
+    std::span<T> trim(std::span<T> last, std::size_t count)
+    {
+        release(reinterpret_cast<unsigned char*>(last.data() + count),
+                reinterpret_cast<unsigned char*>(last.data() + last.size()));
+        return last.first(count);
+    }
+
+    // Everything allocated so far becomes invalid
+    void reset();
+
+    std::size_t   used() const { return m_used; }          // this tick, bytes
+    std::size_t   peak() const { return m_peak; }          // largest tick so far
+    std::size_t   capacity() const { return m_capacity; }  // current block
+    std::uint64_t growths() const { return m_growths; }    // block replacements
+
+private:
+    void release(unsigned char* from, unsigned char* to);
+
+    unsigned char*      m_block{nullptr};
+    std::size_t         m_capacity{0};
+    std::size_t         m_top{0};      // next free byte in m_block
+    std::size_t         m_used{0};     // block + overflow
+    std::size_t         m_peak{0};
+    std::uint64_t       m_growths{0};
+    std::vector<void*>  m_overflow;    // heap blocks past the end of m_block
+};
@@ -0,0 +1,49 @@
+#include "InputQueue.h"
+
+#include <algorithm>
+
+void inputBeginFrame(InputState& state)
+{
+    std::fill(std::begin(state.pressed), std::end(state.pressed), false);
+    state.mouseDeltaX = 0.0f;
+    state.mouseDeltaY = 0.0f;
+}
+
+void inputApply(InputState& state, const InputEvent& e)
+{
+    switch (e.type) {
+    case InputEvent::Type::Key:
+        if (e.key < 0 || e.key >= kInputKeyCount) return;
+        state.keys[e.key] = e.pressed;
+        if (e.pressed) state.pressed[e.key] = true;
+        break;
+    case InputEvent::Type::Cursor:
+        state.mouseDeltaX += e.dx;
+        state.mouseDeltaY += e.dy;
+        break;
+    }
+}
+
+std::size_t inputDrain(InputQueue& queue, InputState& state, InputEvent::Clock::time_point until)
+{
+    std::size_t applied = 0;
+    while (const InputEvent* e = queue.front()) {
+        if (e->time > until) break;  // belongs to a later window
+        inputApply(state, *e);
+        queue.pop();
+        ++applied;
+    }
+    return applied;
+}
+
+bool inputKey(const InputState& state, int key)
+{
+    if (key < 0 || key >= kInputKeyCount) return false;
+    return state.keys[key];
+}
+
+bool inputPressed(const InputState& state, int key)
+{
+    if (key < 0 || key >= kInputKeyCount) return false;
+    return state.pressed[key];
+}
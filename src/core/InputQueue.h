@@ -0,0 +1,45 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include "SpscQueue.h"
+
+// Timestamped input events, from the window thread to each consumer
+// (render loop, simulation) through its own SPSC ring. No GLFW in core:
+// key codes are carried as-is and kInputKeyCount covers them.
+
+constexpr int kInputKeyCount = 512;
+
+struct InputEvent {
+    using Clock = std::chrono::steady_clock;
+
+    enum class Type : std::uint8_t { Key, Cursor };
+
+    Clock::time_point time;      // when the window system handed it over
+    Type              type{Type::Key};
+    bool              pressed{false};  // Key: press (or repeat) vs release
+    std::int16_t      key{0};
+    float             dx{0.0f};  // Cursor: movement since the last event, y up
+    float             dy{0.0f};
+};
+
+using InputQueue = SpscQueue<InputEvent, 1024>;
+
+// Consumer-side view built by replaying events
+struct InputState {
+    bool  keys[kInputKeyCount]{};     // held
+    bool  pressed[kInputKeyCount]{};  // went down since inputBeginFrame(), even if released again
+    float mouseDeltaX{0.0f};
+    float mouseDeltaY{0.0f};
+};
+
+// Clears the per-window parts (presses, mouse deltas); held keys carry over
+void inputBeginFrame(InputState& state);
+void inputApply(InputState& state, const InputEvent& event);
+
+// Applies queued events timestamped at or before `until`, leaving later
+// ones for the next window; returns how many were applied
+std::size_t inputDrain(InputQueue& queue, InputState& state,
+                       InputEvent::Clock::time_point until = InputEvent::Clock::time_point::max());
+
+bool inputKey(const InputState& state, int key);
+bool inputPressed(const InputState& state, int key);
@@ -0,0 +1,182 @@
+#include "Integrator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define INTEGRATOR_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define INTEGRATOR_SSE2 1
+#endif
+
+// ---------- linear + angular velocity, position ----------
+
+static void integrateVelocities(BodyStore& b, std::size_t begin, std::size_t end,
+                                glm::vec3 g, float dt)
+{
+    const float* invMass = b.invMass.data();
+    const float* invI    = b.invInertia.data();
+    const float* awake   = b.awake.data();
+    const float* fx = b.fx.data(); const float* fy = b.fy.data(); const float* fz = b.fz.data();
+    const float* tx = b.tx.data(); const float* ty = b.ty.data(); const float* tz = b.tz.data();
+    float* vx = b.vx.data(); float* vy = b.vy.data(); float* vz = b.vz.data();
+    float* px = b.px.data(); float* py = b.py.data(); float* pz = b.pz.data();
+    float* wx = b.wx.data(); float* wy = b.wy.data(); float* wz = b.wz.data();
+
+    // Branch-free: static and sleeping bodies get h = 0 instead of an early-out
+    for (std::size_t i = begin; i < end; ++i) {
+        float h = invMass[i] != 0.0f ? dt * awake[i] : 0.0f;
+        vx[i] += (fx[i] * invMass[i] + g.x) * h;
+        vy[i] += (fy[i] * invMass[i] + g.y) * h;
+        vz[i] += (fz[i] * invMass[i] + g.z) * h;
+        px[i] += vx[i] * h;
+        py[i] += vy[i] * h;
+        pz[i] += vz[i] * h;
+        wx[i] += tx[i] * invI[i] * h;
+        wy[i] += ty[i] * invI[i] * h;
+        wz[i] += tz[i] * invI[i] * h;
+    }
+}
+
+// ---------- orientation ----------
+// q += 0.5*dt * (0, ω) * q, then renormalize.
+
+static void integrateOrientationScalar(BodyStore& b, std::size_t begin, std::size_t end,
+                                       float dt)
+{
+    for (std::size_t i = begin; i < end; ++i) {
+        float h  = b.invMass[i] != 0.0f ? 0.5f * dt * b.awake[i] : 0.0f;
+        float ax = b.wx[i] * h, ay = b.wy[i] * h, az = b.wz[i] * h;
+        float w = b.qw[i], x = b.qx[i], y = b.qy[i], z = b.qz[i];
+
+        float nw = w - (ax * x + ay * y + az * z);
+        float nx = x + (w * ax + ay * z - az * y);
+        float ny = y + (w * ay + az * x - ax * z);
+        float nz = z + (w * az + ax * y - ay * x);
+
+        float len = std::sqrt(nw * nw + nx * nx + ny * ny + nz * nz);
+        b.qw[i] = nw / len; b.qx[i] = nx / len; b.qy[i] = ny / len; b.qz[i] = nz / len;
+    }
+}
+
+#if defined(INTEGRATOR_AVX)
+
+static std::size_t integrateOrientationWide(BodyStore& b, std::size_t begin, std::size_t end,
+                                            float dt)
+{
+    const __m256 half = _mm256_set1_ps(0.5f * dt);
+    const __m256 zero = _mm256_setzero_ps();
+
+    std::size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 dyn = _mm256_cmp_ps(_mm256_loadu_ps(&b.invMass[i]), zero, _CMP_NEQ_OQ);
+        __m256 h   = _mm256_and_ps(dyn, _mm256_mul_ps(half, _mm256_loadu_ps(&b.awake[i])));
+        __m256 ax  = _mm256_mul_ps(_mm256_loadu_ps(&b.wx[i]), h);
+        __m256 ay  = _mm256_mul_ps(_mm256_loadu_ps(&b.wy[i]), h);
+        __m256 az  = _mm256_mul_ps(_mm256_loadu_ps(&b.wz[i]), h);
+        __m256 w   = _mm256_loadu_ps(&b.qw[i]);
+        __m256 x   = _mm256_loadu_ps(&b.qx[i]);
+        __m256 y   = _mm256_loadu_ps(&b.qy[i]);
+        __m256 z   = _mm256_loadu_ps(&b.qz[i]);
+
+        __m256 nw = _mm256_sub_ps(w, _mm256_add_ps(_mm256_add_ps(
+                        _mm256_mul_ps(ax, x), _mm256_mul_ps(ay, y)), _mm256_mul_ps(az, z)));
+        __m256 nx = _mm256_add_ps(x, _mm256_sub_ps(_mm256_add_ps(
+                        _mm256_mul_ps(w, ax), _mm256_mul_ps(ay, z)), _mm256_mul_ps(az, y)));
+        __m256 ny = _mm256_add_ps(y, _mm256_sub_ps(_mm256_add_ps(
+                        _mm256_mul_ps(w, ay), _mm256_mul_ps(az, x)), _mm256_mul_ps(ax, z)));
+        __m256 nz = _mm256_add_ps(z, _mm256_sub_ps(_mm256_add_ps(
+                        _mm256_mul_ps(w, az), _mm256_mul_ps(ax, y)), _mm256_mul_ps(ay, x)));
+
+        __m256 len = _mm256_sqrt_ps(_mm256_add_ps(
+                        _mm256_add_ps(_mm256_mul_ps(nw, nw), _mm256_mul_ps(nx, nx)),
+                        _mm256_add_ps(_mm256_mul_ps(ny, ny), _mm256_mul_ps(nz, nz))));
+        _mm256_storeu_ps(&b.qw[i], _mm256_div_ps(nw, len));
+        _mm256_storeu_ps(&b.qx[i], _mm256_div_ps(nx, len));
+        _mm256_storeu_ps(&b.qy[i], _mm256_div_ps(ny, len));
+        _mm256_storeu_ps(&b.qz[i], _mm256_div_ps(nz, len));
+    }
+    return i;
+}
+
+#elif defined(INTEGRATOR_SSE2)
+
+static std::size_t integrateOrientationWide(BodyStore& b, std::size_t begin, std::size_t end,
+                                            float dt)
+{
+    const __m128 half = _mm_set1_ps(0.5f * dt);
+    const __m128 zero = _mm_setzero_ps();
+
+    std::size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 dyn = _mm_cmpneq_ps(_mm_loadu_ps(&b.invMass[i]), zero);
+        __m128 h   = _mm_and_ps(dyn, _mm_mul_ps(half, _mm_loadu_ps(&b.awake[i])));
+        __m128 ax  = _mm_mul_ps(_mm_loadu_ps(&b.wx[i]), h);
+        __m128 ay  = _mm_mul_ps(_mm_loadu_ps(&b.wy[i]), h);
+        __m128 az  = _mm_mul_ps(_mm_loadu_ps(&b.wz[i]), h);
+        __m128 w   = _mm_loadu_ps(&b.qw[i]);
+        __m128 x   = _mm_loadu_ps(&b.qx[i]);
+        __m128 y   = _mm_loadu_ps(&b.qy[i]);
+        __m128 z   = _mm_loadu_ps(&b.qz[i]);
+
+        __m128 nw = _mm_sub_ps(w, _mm_add_ps(_mm_add_ps(
+                        _mm_mul_ps(ax, x), _mm_mul_ps(ay, y)), _mm_mul_ps(az, z)));
+        __m128 nx = _mm_add_ps(x, _mm_sub_ps(_mm_add_ps(
+                        _mm_mul_ps(w, ax), _mm_mul_ps(ay, z)), _mm_mul_ps(az, y)));
+        __m128 ny = _mm_add_ps(y, _mm_sub_ps(_mm_add_ps(
+                        _mm_mul_ps(w, ay), _mm_mul_ps(az, x)), _mm_mul_ps(ax, z)));
+        __m128 nz = _mm_add_ps(z, _mm_sub_ps(_mm_add_ps(
+                        _mm_mul_ps(w, az), _mm_mul_ps(ax, y)), _mm_mul_ps(ay, x)));
+
+        __m128 len = _mm_sqrt_ps(_mm_add_ps(
+                        _mm_add_ps(_mm_mul_ps(nw, nw), _mm_mul_ps(nx, nx)),
+                        _mm_add_ps(_mm_mul_ps(ny, ny), _mm_mul_ps(nz, nz))));
+        _mm_storeu_ps(&b.qw[i], _mm_div_ps(nw, len));
+        _mm_storeu_ps(&b.qx[i], _mm_div_ps(nx, len));
+        _mm_storeu_ps(&b.qy[i], _mm_div_ps(ny, len));
+        _mm_storeu_ps(&b.qz[i], _mm_div_ps(nz, len));
+    }
+    return i;
+}
+
+#else
+
+static std::size_t integrateOrientationWide(BodyStore&, std::size_t begin, std::size_t,
+                                            float)
+{
+    return begin;
+}
+
+#endif
+
+// ---------- public API ----------
+
+void integrateRange(BodyStore& bodies, std::size_t begin, std::size_t end,
+                    glm::vec3 gravity, float dt)
+{
+    integrateVelocities(bodies, begin, end, gravity, dt);
+
+    std::size_t done = integrateOrientationWide(bodies, begin, end, dt);
+    integrateOrientationScalar(bodies, done, end, dt);
+
+    for (auto* a : {&bodies.fx, &bodies.fy, &bodies.fz,
+                    &bodies.tx, &bodies.ty, &bodies.tz})
+        std::fill(a->begin() + static_cast<std::ptrdiff_t>(begin),
+                  a->begin() + static_cast<std::ptrdiff_t>(end), 0.0f);
+}
+
+void integrateAll(BodyStore& bodies, glm::vec3 gravity, float dt)
+{
+    integrateRange(bodies, 0, bodies.size(), gravity, dt);
+}
+
+void integrateAll(BodyStore& bodies, glm::vec3 gravity, float dt, ThreadPool& pool)
+{
+    // Multiple of 8 keeps every chunk on the wide path
+    constexpr std::size_t grain = 4096;
+    pool.parallelFor(bodies.size(), grain, [&](std::size_t begin, std::size_t end) {
+        integrateRange(bodies, begin, end, gravity, dt);
+    });
+}
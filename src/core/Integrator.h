@@ -0,0 +1,20 @@
+#pragma once
+#include <glm/glm.hpp>
+#include "BodyStore.h"
+#include "ThreadPool.h"
+
+// Semi-implicit Euler over every body in the store: same math as
+// integrate(RigidBody&, float) plus a uniform gravity acceleration.
+// Static (invMass == 0) and sleeping bodies don't move. Clears force/torque
+// accumulators.
+//
+// Linear/angular velocity and position updates are plain loops the compiler
+// vectorizes; the quaternion update runs 8 (AVX) or 4 (SSE2) bodies per step.
+void integrateAll(BodyStore& bodies, glm::vec3 gravity, float dt);
+
+// Bodies [begin, end) only; chunks are independent.
+void integrateRange(BodyStore& bodies, std::size_t begin, std::size_t end,
+                    glm::vec3 gravity, float dt);
+
+// Splits the store across the pool.
+void integrateAll(BodyStore& bodies, glm::vec3 gravity, float dt, ThreadPool& pool);
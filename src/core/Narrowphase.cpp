@@ -0,0 +1,152 @@
+#include "Narrowphase.h"
+
+#include <bit>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define NARROWPHASE_AVX2 1
+#endif
+
+// ---------- sphere-sphere ----------
+
+static std::size_t testPairsScalar(const BodyStore& s, const BodyPair* pairs,
+                                   std::size_t begin, std::size_t end,
+                                   Contact* out, std::size_t count)
+{
+    for (std::size_t k = begin; k < end; ++k) {
+        const std::uint32_t a = pairs[k].a;
+        const std::uint32_t b = pairs[k].b;
+        float dx    = s.px[b] - s.px[a];
+        float dy    = s.py[b] - s.py[a];
+        float dz    = s.pz[b] - s.pz[a];
+        float dist2 = dx * dx + dy * dy + dz * dz;
+        float rSum  = s.radius[a] + s.radius[b];
+        bool  hit   = dist2 < rSum * rSum && dist2 >= 1e-8f;
+
+        float dist   = std::sqrt(dist2);
+        float inv    = hit ? 1.0f / dist : 0.0f;
+        out[count]   = {a, b, dx * inv, dy * inv, dz * inv, rSum - dist};
+        count       += hit ? 1 : 0;
+    }
+    return count;
+}
+
+#if defined(NARROWPHASE_AVX2)
+
+static std::size_t testPairsWide(const BodyStore& s, const BodyPair* pairs,
+                                 std::size_t n, Contact* out, std::size_t& count)
+{
+    static_assert(sizeof(BodyPair) == 8, "BodyPair must pack as two uint32");
+
+    // Deinterleave 8 (a, b) pairs: [a0 b0 a1 b1 ...] → [a0..a7], [b0..b7]
+    const __m256i evenOdd = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    const __m256  eps     = _mm256_set1_ps(1e-8f);
+
+    std::size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        const auto* raw = reinterpret_cast<const __m256i*>(pairs + k);
+        __m256i lo = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(raw),     evenOdd);
+        __m256i hi = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(raw + 1), evenOdd);
+        __m256i ia = _mm256_permute2x128_si256(lo, hi, 0x20);
+        __m256i ib = _mm256_permute2x128_si256(lo, hi, 0x31);
+
+        __m256 dx = _mm256_sub_ps(_mm256_i32gather_ps(s.px.data(), ib, 4),
+                                  _mm256_i32gather_ps(s.px.data(), ia, 4));
+        __m256 dy = _mm256_sub_ps(_mm256_i32gather_ps(s.py.data(), ib, 4),
+                                  _mm256_i32gather_ps(s.py.data(), ia, 4));
+        __m256 dz = _mm256_sub_ps(_mm256_i32gather_ps(s.pz.data(), ib, 4),
+                                  _mm256_i32gather_ps(s.pz.data(), ia, 4));
+        __m256 rSum = _mm256_add_ps(_mm256_i32gather_ps(s.radius.data(), ia, 4),
+                                    _mm256_i32gather_ps(s.radius.data(), ib, 4));
+
+        __m256 dist2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx),
+                                                   _mm256_mul_ps(dy, dy)),
+                                     _mm256_mul_ps(dz, dz));
+        __m256 hit = _mm256_and_ps(
+            _mm256_cmp_ps(dist2, _mm256_mul_ps(rSum, rSum), _CMP_LT_OQ),
+            _mm256_cmp_ps(dist2, eps, _CMP_GE_OQ));
+
+        int mask = _mm256_movemask_ps(hit);
+        if (mask == 0) continue;
+
+        __m256 dist = _mm256_sqrt_ps(dist2);
+        __m256 inv  = _mm256_and_ps(hit, _mm256_div_ps(_mm256_set1_ps(1.0f), dist));
+
+        alignas(32) float nx[8], ny[8], nz[8], pen[8];
+        _mm256_store_ps(nx,  _mm256_mul_ps(dx, inv));
+        _mm256_store_ps(ny,  _mm256_mul_ps(dy, inv));
+        _mm256_store_ps(nz,  _mm256_mul_ps(dz, inv));
+        _mm256_store_ps(pen, _mm256_sub_ps(rSum, dist));
+
+        // Compact hit lanes, preserving pair order
+        while (mask) {
+            int lane = std::countr_zero(static_cast<unsigned>(mask));
+            mask &= mask - 1;
+            const BodyPair& p = pairs[k + static_cast<std::size_t>(lane)];
+            out[count++] = {p.a, p.b, nx[lane], ny[lane], nz[lane], pen[lane]};
+        }
+    }
+    return k;
+}
+
+#else
+
+static std::size_t testPairsWide(const BodyStore&, const BodyPair*, std::size_t,
+                                 Contact*, std::size_t&)
+{
+    return 0;
+}
+
+#endif
+
+std::span<Contact> findSphereContacts(const BodyStore& bodies, std::span<const BodyPair> pairs,
+                                      FrameArena& arena)
+{
+    // Worst case every pair hits; trimmed to the real count below
+    std::span<Contact> out = arena.alloc<Contact>(pairs.size());
+
+    std::size_t count = 0;
+    std::size_t done  = testPairsWide(bodies, pairs.data(), pairs.size(), out.data(), count);
+    count = testPairsScalar(bodies, pairs.data(), done, pairs.size(), out.data(), count);
+
+    return arena.trim(out, count);
+}
+
+// ---------- sphere-floor ----------
+
+std::span<std::uint32_t> findFloorContacts(const BodyStore& bodies, float floorY,
+                                           FrameArena& arena)
+{
+    const std::size_t        n   = bodies.size();
+    std::span<std::uint32_t> out = arena.alloc<std::uint32_t>(n);
+
+    const float* py    = bodies.py.data();
+    const float* r     = bodies.radius.data();
+    const float* awake = bodies.awake.data();
+    std::size_t  count = 0;
+    std::size_t  i     = 0;
+
+#if defined(NARROWPHASE_AVX2)
+    const __m256 floorV = _mm256_set1_ps(floorY);
+    const __m256 zero   = _mm256_setzero_ps();
+    for (; i + 8 <= n; i += 8) {
+        __m256 bottom = _mm256_sub_ps(_mm256_loadu_ps(py + i), _mm256_loadu_ps(r + i));
+        __m256 hit    = _mm256_and_ps(_mm256_cmp_ps(bottom, floorV, _CMP_LT_OQ),
+                                      _mm256_cmp_ps(_mm256_loadu_ps(awake + i), zero, _CMP_NEQ_OQ));
+        int    mask   = _mm256_movemask_ps(hit);
+        while (mask) {
+            int lane = std::countr_zero(static_cast<unsigned>(mask));
+            mask &= mask - 1;
+            out[count++] = static_cast<std::uint32_t>(i + static_cast<std::size_t>(lane));
+        }
+    }
+#endif
+
+    for (; i < n; ++i) {
+        out[count] = static_cast<std::uint32_t>(i);
+        count     += (py[i] - r[i] < floorY && awake[i] != 0.0f) ? 1 : 0;
+    }
+
+    return arena.trim(out, count);
+}
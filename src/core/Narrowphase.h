@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include "BodyStore.h"
+#include "Broadphase.h"
+#include "FrameArena.h"
+
+// Penetrating sphere pair, normal points A → B.
+struct Contact {
+    std::uint32_t a;
+    std::uint32_t b;
+    float         nx, ny, nz;
+    float         penetration;
+};
+
+// Batched narrowphase: tests every candidate pair against one position
+// snapshot and returns the penetrating ones, in pair order, from `arena`.
+// AVX2 builds gather and test 8 pairs per step; otherwise a branch-free
+// scalar loop. No early-outs either way — misses just don't advance the cursor.
+std::span<Contact> findSphereContacts(const BodyStore& bodies, std::span<const BodyPair> pairs,
+                                      FrameArena& arena);
+
+// Awake bodies whose sphere dips below floorY, ascending index order.
+std::span<std::uint32_t> findFloorContacts(const BodyStore& bodies, float floorY,
+                                           FrameArena& arena);
@@ -0,0 +1,155 @@
+#include "Profiler.h"
+
+#include <cstdio>
+
+#if defined(PROFILER_ENABLED)
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> g_profilerEnabled{false};
+
+namespace {
+
+constexpr std::uint64_t kRingEvents = 1u << 15;  // per track, ~768 KiB
+
+struct ProfileEvent {
+    const char*   name;
+    std::uint64_t begin;
+    std::uint64_t end;
+};
+
+// Single-producer ring: the owner stores the event, then publishes head
+struct ProfileTrack {
+    char                       name[32]{};
+    std::atomic<std::uint64_t> head{0};  // events ever recorded
+    ProfileEvent               events[kRingEvents];
+
+    void push(const char* n, std::uint64_t b, std::uint64_t e)
+    {
+        const std::uint64_t h = head.load(std::memory_order_relaxed);
+        events[h % kRingEvents] = {n, b, e};
+        head.store(h + 1, std::memory_order_release);
+    }
+};
+
+using Clock = std::chrono::steady_clock;
+const Clock::time_point g_epoch = Clock::now();
+
+// Tracks live until exit; a track's index is its trace tid
+std::mutex                                 g_tracksMutex;
+std::vector<std::unique_ptr<ProfileTrack>> g_tracks;
+
+ProfileTrack* addTrack(const char* name)
+{
+    std::lock_guard<std::mutex> lock(g_tracksMutex);
+    g_tracks.push_back(std::make_unique<ProfileTrack>());
+    ProfileTrack* t = g_tracks.back().get();
+    if (name)
+        std::snprintf(t->name, sizeof(t->name), "%s", name);
+    else
+        std::snprintf(t->name, sizeof(t->name), "thread %zu", g_tracks.size() - 1);
+    return t;
+}
+
+ProfileTrack& threadTrack()
+{
+    thread_local ProfileTrack* track = addTrack(nullptr);
+    return *track;
+}
+
+} // namespace
+
+void profilerSetEnabled(bool enabled)
+{
+    g_profilerEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+std::uint64_t profilerNow()
+{
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - g_epoch).count());
+}
+
+void profilerSetThreadName(const char* name)
+{
+    ProfileTrack& t = threadTrack();
+    std::lock_guard<std::mutex> lock(g_tracksMutex);
+    std::snprintf(t.name, sizeof(t.name), "%s", name);
+}
+
+void profilerRecord(const char* name, std::uint64_t begin, std::uint64_t end)
+{
+    threadTrack().push(name, begin, end);
+}
+
+std::uint32_t profilerCreateTrack(const char* name)
+{
+    addTrack(name);
+    std::lock_guard<std::mutex> lock(g_tracksMutex);
+    return static_cast<std::uint32_t>(g_tracks.size() - 1);
+}
+
+void profilerRecordOn(std::uint32_t track, const char* name,
+                      std::uint64_t begin, std::uint64_t end)
+{
+    ProfileTrack* t;
+    {
+        std::lock_guard<std::mutex> lock(g_tracksMutex);  // vector may grow
+        t = g_tracks[track].get();
+    }
+    t->push(name, begin, end);
+}
+
+// ---------- export ----------
+
+bool profilerWriteTrace(const char* path)
+{
+    std::FILE* f = std::fopen(path, "w");
+    if (!f) {
+        std::fprintf(stderr, "Profiler: cannot open %s for writing\n", path);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(g_tracksMutex);
+
+    std::size_t written = 0;
+    std::fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (std::size_t tid = 0; tid < g_tracks.size(); ++tid) {
+        const ProfileTrack& t = *g_tracks[tid];
+        std::fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%zu,"
+                        "\"args\":{\"name\":\"%s\"}}",
+                     tid ? ",\n" : "", tid, t.name);
+
+        const std::uint64_t head  = t.head.load(std::memory_order_acquire);
+        const std::uint64_t first = head > kRingEvents ? head - kRingEvents : 0;
+        for (std::uint64_t k = first; k < head; ++k) {
+            const ProfileEvent& e = t.events[k % kRingEvents];
+            std::fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%zu,"
+                            "\"ts\":%.3f,\"dur\":%.3f}",
+                         e.name, tid, static_cast<double>(e.begin) * 1e-3,
+                         static_cast<double>(e.end - e.begin) * 1e-3);
+        }
+        written += static_cast<std::size_t>(head - first);
+    }
+    std::fprintf(f, "\n]}\n");
+
+    const bool ok = std::fclose(f) == 0;
+    if (ok)
+        std::printf("Profiler: wrote %zu events to %s\n", written, path);
+    else
+        std::fprintf(stderr, "Profiler: write to %s failed\n", path);
+    return ok;
+}
+
+#else
+
+bool profilerWriteTrace(const char* path)
+{
+    std::fprintf(stderr, "Profiler: built with PROFILER=OFF, not writing %s\n", path);
+    return false;
+}
+
+#endif
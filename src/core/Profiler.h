@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+
+// Scoped frame profiler with Chrome trace export (chrome://tracing, Perfetto).
+//
+//   PROFILE_SCOPE("solve");      // records [construction, destruction)
+//
+// Each thread records into its own fixed ring of events: one relaxed load
+// when disabled at run time, two clock reads and a ring store when enabled.
+// The oldest events are overwritten once a ring wraps. Configure with
+// -DPROFILER=OFF to compile every marker out; the functions below then
+// become no-ops.
+
+#if defined(PROFILER_ENABLED)
+
+#include <atomic>
+
+extern std::atomic<bool> g_profilerEnabled;
+
+inline bool profilerEnabled() { return g_profilerEnabled.load(std::memory_order_relaxed); }
+void profilerSetEnabled(bool enabled);
+
+// Nanoseconds on the steady clock since the profiler's epoch
+std::uint64_t profilerNow();
+
+// Names the calling thread's track (default "thread N")
+void profilerSetThreadName(const char* name);
+
+// `name` must outlive the profiler (string literals)
+void profilerRecord(const char* name, std::uint64_t begin, std::uint64_t end);
+
+// Extra track for events timed elsewhere (GPU). Record from one thread only.
+std::uint32_t profilerCreateTrack(const char* name);
+void          profilerRecordOn(std::uint32_t track, const char* name,
+                               std::uint64_t begin, std::uint64_t end);
+
+// trace_event JSON of everything still in the rings. Call while no other
+// thread is recording.
+bool profilerWriteTrace(const char* path);
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : m_name(profilerEnabled() ? name : nullptr), m_begin(m_name ? profilerNow() : 0) {}
+    ~ProfileScope()
+    {
+        if (m_name) profilerRecord(m_name, m_begin, profilerNow());
+    }
+
+    ProfileScope(const ProfileScope&)            = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char*   m_name;
+    std::uint64_t m_begin;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b)  PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(name)   ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+#else
+
+inline bool          profilerEnabled() { return false; }
+inline void          profilerSetEnabled(bool) {}
+inline std::uint64_t profilerNow() { return 0; }
+inline void          profilerSetThreadName(const char*) {}
+inline void          profilerRecord(const char*, std::uint64_t, std::uint64_t) {}
+inline std::uint32_t profilerCreateTrack(const char*) { return 0; }
+inline void          profilerRecordOn(std::uint32_t, const char*, std::uint64_t, std::uint64_t) {}
+bool                 profilerWriteTrace(const char* path);  // reports the build option
+
+#define PROFILE_SCOPE(name) ((void)0)
+
+#endif
@@ -12,8 +12,11 @@ struct RigidBody {
     float     radius         {0.5f};
     glm::vec3 accumForce     {0.0f, 0.0f, 0.0f};
     glm::vec3 accumTorque    {0.0f, 0.0f, 0.0f};
+    bool      awake          {true};   // false = skipped until woken
+    float     sleepTimer     {0.0f};   // seconds spent below the sleep thresholds
 
-    void applyForce (glm::vec3 f) { accumForce  += f; }
-    void applyTorque(glm::vec3 t) { accumTorque += t; }
+    void wake() { awake = true; sleepTimer = 0.0f; }
+    void applyForce (glm::vec3 f) { accumForce  += f; wake(); }
+    void applyTorque(glm::vec3 t) { accumTorque += t; wake(); }
     void clearForces() { accumForce = {}; accumTorque = {}; }
 };
@@ -0,0 +1,200 @@
+#include "Rollback.h"
+#include "Profiler.h"
+#include "Simulation.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+RollbackRing::RollbackRing(std::size_t capacity, std::size_t bodyCount,
+                           std::size_t maxInputsPerTick, bool deltas)
+    : m_bodyCount(bodyCount), m_maxInputs(maxInputsPerTick), m_deltas(deltas)
+{
+    BodyStore{}.forEachArray([this](const auto&) { ++m_arrayCount; });
+    m_blocksPerArray = (bodyCount + kBlockFloats - 1) / kBlockFloats;
+
+    // Two slots minimum: a delta save needs the tick before it still held
+    m_slots.resize(std::max<std::size_t>(capacity, 2));
+    for (Slot& s : m_slots) {
+        s.data.resize(m_arrayCount * bodyCount);
+        s.source.resize(m_arrayCount * m_blocksPerArray);
+        s.inputs.reserve(maxInputsPerTick);
+    }
+}
+
+std::uint64_t RollbackRing::oldestTick() const
+{
+    std::uint64_t oldest = m_tick;
+    for (const Slot& s : m_slots)
+        if (s.saved) oldest = std::min(oldest, s.tick);
+    return oldest;
+}
+
+bool RollbackRing::holds(std::uint64_t tick) const
+{
+    const Slot& s = m_slots[slotOf(tick)];
+    return s.saved && s.tick == tick;
+}
+
+// ---------- slot reuse ----------
+
+RollbackRing::Slot& RollbackRing::claim(std::uint64_t tick)
+{
+    const std::size_t index = slotOf(tick);
+    Slot&             s     = m_slots[index];
+    if (s.tick != tick) {
+        release(index);
+        s.tick  = tick;
+        s.saved = false;
+        s.inputs.clear();
+    }
+    return s;
+}
+
+// Blocks the next tick borrowed from this slot move into the next tick's
+// own buffer before the slot is overwritten. References always point at
+// the slot that holds the data, and a block is only borrowed when the
+// tick before borrowed it too, so checking the next tick finds them all.
+void RollbackRing::release(std::size_t index)
+{
+    const Slot& s = m_slots[index];
+    if (!s.saved || !holds(s.tick + 1)) return;
+
+    const std::size_t nextIndex = slotOf(s.tick + 1);
+    Slot&             next      = m_slots[nextIndex];
+
+    for (std::size_t k = 0; k < m_arrayCount; ++k) {
+        for (std::size_t b = 0; b < m_blocksPerArray; ++b) {
+            const std::size_t kb = k * m_blocksPerArray + b;
+            if (next.source[kb] != index) continue;
+
+            const std::size_t at  = k * m_bodyCount + b * kBlockFloats;
+            const std::size_t len = std::min(kBlockFloats, m_bodyCount - b * kBlockFloats);
+            std::memcpy(next.data.data() + at, s.data.data() + at, len * sizeof(float));
+            next.source[kb] = static_cast<std::uint32_t>(nextIndex);
+
+            for (std::uint64_t t = s.tick + 2; holds(t); ++t) {
+                std::uint32_t& src = m_slots[slotOf(t)].source[kb];
+                if (src == index) src = static_cast<std::uint32_t>(nextIndex);
+            }
+        }
+    }
+}
+
+// ---------- save / restore ----------
+
+void RollbackRing::save(std::uint64_t tick, const SimState& sim)
+{
+    PROFILE_SCOPE("rollback save");
+
+    Slot& s = claim(tick);
+    s.saved = false;
+    if (sim.bodies.size() != m_bodyCount) {
+        std::fprintf(stderr, "RollbackRing: %zu bodies, ring was sized for %zu\n",
+                     sim.bodies.size(), m_bodyCount);
+        return;
+    }
+
+    const std::size_t index = slotOf(tick);
+    const Slot*       prev  = m_deltas && tick > 0 && holds(tick - 1) ? &m_slots[slotOf(tick - 1)]
+                                                                      : nullptr;
+    std::size_t bytes = 0;
+    std::size_t k     = 0;
+    sim.bodies.forEachArray([&](const std::vector<float>& a) {
+        for (std::size_t b = 0; b < m_blocksPerArray; ++b) {
+            const std::size_t kb  = k * m_blocksPerArray + b;
+            const std::size_t at  = k * m_bodyCount + b * kBlockFloats;
+            const std::size_t len = std::min(kBlockFloats, m_bodyCount - b * kBlockFloats) * sizeof(float);
+            const float*      src = a.data() + b * kBlockFloats;
+
+            if (prev) {
+                const Slot& holder = m_slots[prev->source[kb]];
+                if (std::memcmp(src, holder.data.data() + at, len) == 0) {
+                    s.source[kb] = prev->source[kb];
+                    continue;
+                }
+            }
+            std::memcpy(s.data.data() + at, src, len);
+            s.source[kb] = static_cast<std::uint32_t>(index);
+            bytes += len;
+        }
+        ++k;
+    });
+
+    // Warm-start impulses steer the next solve, so replay needs them too
+    const ContactSolver& solver = sim.scratch.solver;
+    s.sphereCache.assign(solver.sphereCache.begin(), solver.sphereCache.end());
+    s.floorCache.assign(solver.floorCache.begin(), solver.floorCache.end());
+    bytes += (s.sphereCache.size() + s.floorCache.size()) * sizeof(CachedImpulse);
+
+    s.saved         = true;
+    m_lastSaveBytes = bytes;
+}
+
+bool RollbackRing::restore(std::uint64_t tick, SimState& sim) const
+{
+    PROFILE_SCOPE("rollback restore");
+
+    if (!holds(tick) || sim.bodies.size() != m_bodyCount) return false;
+    const Slot& s = m_slots[slotOf(tick)];
+
+    std::size_t k = 0;
+    sim.bodies.forEachArray([&](std::vector<float>& a) {
+        for (std::size_t b = 0; b < m_blocksPerArray; ++b) {
+            const std::size_t at  = k * m_bodyCount + b * kBlockFloats;
+            const std::size_t len = std::min(kBlockFloats, m_bodyCount - b * kBlockFloats);
+            const Slot&       holder = m_slots[s.source[k * m_blocksPerArray + b]];
+            std::memcpy(a.data() + b * kBlockFloats, holder.data.data() + at, len * sizeof(float));
+        }
+        ++k;
+    });
+
+    ContactSolver& solver = sim.scratch.solver;
+    solver.sphereCache.assign(s.sphereCache.begin(), s.sphereCache.end());
+    solver.floorCache.assign(s.floorCache.begin(), s.floorCache.end());
+    return true;
+}
+
+// ---------- inputs / stepping ----------
+
+bool RollbackRing::addInput(std::uint64_t tick, const SimInput& input)
+{
+    if (tick > m_tick || (tick < m_tick && !holds(tick))) return false;
+
+    Slot& s = claim(tick);
+    if (s.inputs.size() >= m_maxInputs) return false;  // capacity is fixed
+    s.inputs.push_back(input);
+    return true;
+}
+
+void RollbackRing::applyInputs(const Slot& slot, SimState& sim) const
+{
+    for (const SimInput& in : slot.inputs) {
+        if (in.body >= sim.bodies.size()) continue;
+        sim.bodies.applyForce(in.body, in.force);
+        sim.bodies.applyTorque(in.body, in.torque);
+    }
+}
+
+void RollbackRing::step(SimState& sim, float dt)
+{
+    save(m_tick, sim);
+    applyInputs(m_slots[slotOf(m_tick)], sim);
+    stepSimulation(sim, dt);
+    ++m_tick;
+}
+
+bool RollbackRing::resimulateFrom(std::uint64_t tick, SimState& sim, float dt)
+{
+    PROFILE_SCOPE("resimulate");
+
+    if (tick >= m_tick || !restore(tick, sim)) return false;
+
+    // Later saves are rewritten on the way: their state may change now
+    for (std::uint64_t t = tick; t < m_tick; ++t) {
+        if (t != tick) save(t, sim);
+        applyInputs(m_slots[slotOf(t)], sim);
+        stepSimulation(sim, dt);
+    }
+    return true;
+}
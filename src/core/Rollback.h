@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "SimState.h"
+
+// Force and torque on one body for one tick: the unit of replayable input
+struct SimInput {
+    std::uint32_t body;
+    glm::vec3     force;
+    glm::vec3     torque;
+};
+
+// The last `capacity` ticks of simulation state plus the inputs applied at
+// each, for rewinding and deterministic replay.
+//
+// Every slot is allocated up front for a fixed body count: saving and
+// restoring are memcpys, and only the solver's warm-start cache can grow
+// (to its high-water mark). With deltas on, a save compares each
+// kBlockFloats run of each BodyStore array with the tick before and keeps
+// a reference instead of a copy when nothing changed — force accumulators,
+// mass and radius, and every array of a settled region.
+//
+// Ticks are consecutive. step() saves the state at the start of the tick,
+// applies that tick's inputs and steps; resimulateFrom() restores an older
+// tick and replays forward to the current one, picking up inputs added
+// late with addInput().
+class RollbackRing {
+public:
+    static constexpr std::size_t kBlockFloats = 1024;
+
+    RollbackRing(std::size_t capacity, std::size_t bodyCount,
+                 std::size_t maxInputsPerTick = 64, bool deltas = true);
+
+    RollbackRing(const RollbackRing&)            = delete;
+    RollbackRing& operator=(const RollbackRing&) = delete;
+
+    // Input for `tick`, from oldestTick() up to currentTick(). An input for
+    // a past tick only takes effect after resimulateFrom(tick).
+    bool addInput(std::uint64_t tick, const SimInput& input);
+
+    // Save, apply currentTick()'s inputs, stepSimulation(), advance
+    void step(SimState& sim, float dt);
+
+    // Restore `tick`'s saved state and replay up to currentTick(); false
+    // (sim untouched) when the tick has left the ring
+    bool resimulateFrom(std::uint64_t tick, SimState& sim, float dt);
+
+    // State as of the start of `tick`; false when it isn't in the ring
+    bool restore(std::uint64_t tick, SimState& sim) const;
+
+    std::uint64_t currentTick() const { return m_tick; }   // next tick step() runs
+    std::uint64_t oldestTick() const;
+    std::size_t   capacity() const { return m_slots.size(); }
+    std::size_t   lastSaveBytes() const { return m_lastSaveBytes; }  // copied, deltas skip the rest
+
+private:
+    struct Slot {
+        std::uint64_t              tick{~std::uint64_t{0}};
+        bool                       saved{false};
+        std::vector<float>         data;        // arrays back to back, bodyCount floats each
+        std::vector<std::uint32_t> source;      // per block: slot holding its data
+        std::vector<SimInput>      inputs;      // capacity fixed at maxInputsPerTick
+        std::vector<CachedImpulse> sphereCache;
+        std::vector<CachedImpulse> floorCache;
+    };
+
+    std::size_t slotOf(std::uint64_t tick) const { return static_cast<std::size_t>(tick % m_slots.size()); }
+    bool        holds(std::uint64_t tick) const;
+    Slot&       claim(std::uint64_t tick);
+    void        release(std::size_t index);
+    void        save(std::uint64_t tick, const SimState& sim);
+    void        applyInputs(const Slot& slot, SimState& sim) const;
+
+    std::vector<Slot> m_slots;
+    std::size_t       m_bodyCount{0};
+    std::size_t       m_arrayCount{0};
+    std::size_t       m_blocksPerArray{0};
+    std::size_t       m_maxInputs{0};
+    bool              m_deltas{true};
+    std::uint64_t     m_tick{0};
+    std::size_t       m_lastSaveBytes{0};
+};
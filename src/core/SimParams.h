@@ -0,0 +1,26 @@
+#pragma once
+#include <glm/glm.hpp>
+
+// World constants used by stepSimulation()
+struct SimParams {
+    glm::vec3 gravity        {0.0f, -9.81f, 0.0f};
+    float     restitution    {0.6f};
+    float     friction       {0.5f};
+    float     rollingFriction{0.05f};  // floor only; resists rolling and spin
+    float     floorY         {0.0f};
+
+    // Contact solver
+    int   velocityIterations  {8};
+    float restitutionThreshold{0.5f};  // m/s; slower impacts don't bounce
+
+    // Continuous collision: bodies moving further than this many radii in
+    // one tick are swept instead of tested only where the tick ends
+    bool  continuousCollision{true};
+    float ccdMotionThreshold {1.0f};
+
+    // Sleeping: still for sleepTime seconds → skipped until woken
+    bool  allowSleep       {true};
+    float sleepLinearSpeed {0.05f};  // m/s
+    float sleepAngularSpeed{0.1f};   // rad/s
+    float sleepTime        {0.5f};   // s
+};
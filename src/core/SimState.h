@@ -1,9 +1,51 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <vector>
+#include <glm/glm.hpp>
 #include "Camera.h"
-#include "RigidBody.h"
+#include "BodyStore.h"
+#include "Broadphase.h"
+#include "Continuous.h"
+#include "FrameArena.h"
+#include "Narrowphase.h"
+#include "ContactSolver.h"
+#include "SimParams.h"
+
+class ThreadPool;
+
+// Counters from the last stepSimulation()
+struct SimStats {
+    std::size_t pairsTested  {0};  // broadphase distance tests
+    std::size_t candidates   {0};  // pairs handed to the narrowphase
+    std::size_t contacts     {0};  // penetrating sphere pairs
+    std::size_t floorContacts{0};
+    std::size_t warmStarted  {0};  // contacts with a cached impulse
+    std::size_t awakeBodies  {0};
+    std::size_t sweptBodies  {0};  // fast enough for continuous collision
+    std::size_t sweepHits    {0};  // swept bodies pulled back to an impact
+    std::size_t arenaBytes   {0};  // FrameArena use this tick
+};
+
+// Per-tick working state. Transient lists come from `arena`, which
+// stepSimulation() rewinds at the start of every tick — so last tick's
+// lists stay readable until the next step; the rest is kept across ticks
+// so steady state doesn't reallocate.
+struct StepScratch {
+    FrameArena                 arena;
+    Broadphase                 broadphase;
+    ContinuousCollision        continuous;
+    std::span<Contact>         contacts;
+    ContactSolver              solver;  // also holds the cross-tick impulse cache
+    std::span<std::uint32_t>   floorContacts;
+};
 
 struct SimState {
-    Camera                 camera;
-    std::vector<RigidBody> bodies;
+    Camera      camera;
+    BodyStore   bodies;
+    SimParams   params;
+    SimStats    stats;
+    StepScratch scratch;
+    ThreadPool* pool{nullptr};  // optional workers; null = caller thread only
 };
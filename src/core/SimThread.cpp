@@ -0,0 +1,123 @@
+#include "SimThread.h"
+#include "Profiler.h"
+#include "Simulation.h"
+
+SimThread::~SimThread()
+{
+    stop();
+}
+
+void SimThread::setInput(InputQueue& queue, TickInputFn onTick)
+{
+    m_input  = &queue;
+    m_onTick = std::move(onTick);
+}
+
+void SimThread::start(SimState& sim, float dt, float maxLag)
+{
+    m_sim    = &sim;
+    m_dt     = dt;
+    m_maxLag = maxLag;
+    m_tick   = 0;
+    m_stop.store(false, std::memory_order_relaxed);
+
+    // Tick 0 = the initial state, visible before the thread's first step
+    m_start = RenderState::Clock::now();
+    savePrevious();
+    publish(m_start);
+    m_states.update();
+
+    m_thread = std::thread([this] { run(); });
+}
+
+void SimThread::run()
+{
+    profilerSetThreadName("simulation");
+
+    using Clock = RenderState::Clock;
+    const auto step   = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(m_dt));
+    const auto maxLag = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(m_maxLag));
+    auto       next   = m_start + step;
+
+    while (!m_stop.load(std::memory_order_relaxed)) {
+        const auto now = Clock::now();
+        if (now < next) {
+            std::this_thread::sleep_until(next);
+            continue;
+        }
+        // Too far behind to catch up: drop the backlog
+        if (now - next > maxLag) next = now;
+
+        savePrevious();
+
+        // This tick's window ends at its scheduled time; later events wait
+        if (m_input) {
+            PROFILE_SCOPE("tick input");
+            inputBeginFrame(m_inputState);
+            inputDrain(*m_input, m_inputState, next);
+            if (m_onTick) m_onTick(*m_sim, m_inputState);
+        }
+
+        {
+            PROFILE_SCOPE("physics tick");
+            stepSimulation(*m_sim, m_dt);
+        }
+        ++m_tick;
+        publish(next);
+        next += step;
+    }
+}
+
+void SimThread::stop()
+{
+    if (!m_thread.joinable()) return;
+    m_stop.store(true, std::memory_order_relaxed);
+    m_thread.join();
+}
+
+void SimThread::savePrevious()
+{
+    const BodyStore& b = m_sim->bodies;
+    m_prevPx.assign(b.px.begin(), b.px.end());
+    m_prevPy.assign(b.py.begin(), b.py.end());
+    m_prevPz.assign(b.pz.begin(), b.pz.end());
+    m_prevQx.assign(b.qx.begin(), b.qx.end());
+    m_prevQy.assign(b.qy.begin(), b.qy.end());
+    m_prevQz.assign(b.qz.begin(), b.qz.end());
+    m_prevQw.assign(b.qw.begin(), b.qw.end());
+    m_prevCamera = m_sim->camera;
+}
+
+void SimThread::publish(RenderState::Clock::time_point tickTime)
+{
+    PROFILE_SCOPE("publish");
+
+    const BodyStore& b = m_sim->bodies;
+    RenderState&     s = m_states.writeBuffer();
+    s.tick = m_tick;
+    s.time = tickTime;
+    s.px.assign(b.px.begin(), b.px.end());
+    s.py.assign(b.py.begin(), b.py.end());
+    s.pz.assign(b.pz.begin(), b.pz.end());
+    s.qx.assign(b.qx.begin(), b.qx.end());
+    s.qy.assign(b.qy.begin(), b.qy.end());
+    s.qz.assign(b.qz.begin(), b.qz.end());
+    s.qw.assign(b.qw.begin(), b.qw.end());
+    s.radius.assign(b.radius.begin(), b.radius.end());
+    s.prevPx = m_prevPx;
+    s.prevPy = m_prevPy;
+    s.prevPz = m_prevPz;
+    s.prevQx = m_prevQx;
+    s.prevQy = m_prevQy;
+    s.prevQz = m_prevQz;
+    s.prevQw = m_prevQw;
+    s.camera     = m_sim->camera;
+    s.prevCamera = m_prevCamera;
+    m_states.publish();
+}
+
+const RenderState& SimThread::latest()
+{
+    m_states.update();
+    return m_states.readBuffer();
+}
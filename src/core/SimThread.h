@@ -0,0 +1,101 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "Camera.h"
+#include "InputQueue.h"
+#include "SimState.h"
+#include "TripleBuffer.h"
+
+// Body transforms and camera as of one tick, plus the tick before, for the
+// renderer.
+// Owned by the triple buffer; vectors keep their capacity across ticks.
+struct RenderState {
+    using Clock = std::chrono::steady_clock;
+
+    std::uint64_t     tick{0};
+    Clock::time_point time{};  // wall time the tick is scheduled for
+
+    std::vector<float> px, py, pz, qx, qy, qz, qw, radius;    // after the tick
+    std::vector<float> prevPx, prevPy, prevPz;                // before it
+    std::vector<float> prevQx, prevQy, prevQz, prevQw;
+    Camera             camera, prevCamera;
+
+    std::size_t size() const { return px.size(); }
+
+    // 0 at `time`, 1 one tick later
+    float alpha(Clock::time_point now, float dt) const
+    {
+        const float a = std::chrono::duration<float>(now - time).count() / dt;
+        return a < 0.0f ? 0.0f : (a > 1.0f ? 1.0f : a);
+    }
+
+    // Camera blended from the tick before (0) to this one (1)
+    Camera blendCamera(float a) const
+    {
+        Camera c   = camera;
+        c.position = glm::mix(prevCamera.position, camera.position, a);
+        c.yaw      = glm::mix(prevCamera.yaw, camera.yaw, a);
+        c.pitch    = glm::mix(prevCamera.pitch, camera.pitch, a);
+        c.updateVectors();
+        return c;
+    }
+};
+
+// Fixed-step simulation on its own thread.
+// Ticks are paced against the wall clock (tick k at start + k·dt) and each
+// one publishes a RenderState through a TripleBuffer, so the render thread
+// never waits on physics and vice versa. When ticks fall behind by more
+// than maxLag the schedule is reset rather than caught up.
+// The thread owns `sim` from start() until stop().
+//
+// With setInput(), each tick first replays the queued events timestamped
+// up to its scheduled time, so input reaches the simulation within one tick
+// of arriving rather than one render frame.
+class SimThread {
+public:
+    using TickInputFn = std::function<void(SimState&, const InputState&)>;
+
+    SimThread() = default;
+    ~SimThread();
+
+    SimThread(const SimThread&)            = delete;
+    SimThread& operator=(const SimThread&) = delete;
+
+    // Before start(): onTick(sim, input) runs ahead of every step
+    void setInput(InputQueue& queue, TickInputFn onTick);
+
+    void start(SimState& sim, float dt, float maxLag = 0.05f);
+    void stop();
+
+    // Render thread: newest published state (stable until the next call)
+    const RenderState& latest();
+
+private:
+    void run();
+    void savePrevious();
+    void publish(RenderState::Clock::time_point tickTime);
+
+    using Clock = RenderState::Clock;
+
+    SimState*                 m_sim{nullptr};
+    float                     m_dt{0.0f};
+    float                     m_maxLag{0.0f};
+    std::uint64_t             m_tick{0};
+    Clock::time_point         m_start{};  // tick 0
+    std::thread               m_thread;
+    std::atomic<bool>         m_stop{false};
+    TripleBuffer<RenderState> m_states;
+
+    InputQueue*               m_input{nullptr};
+    TickInputFn               m_onTick;
+    InputState                m_inputState;  // sim thread only
+
+    // Transforms before the current tick (sim thread only)
+    std::vector<float> m_prevPx, m_prevPy, m_prevPz;
+    std::vector<float> m_prevQx, m_prevQy, m_prevQz, m_prevQw;
+    Camera             m_prevCamera;
+};
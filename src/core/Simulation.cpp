@@ -0,0 +1,69 @@
+#include "Simulation.h"
+#include "Integrator.h"
+#include "Profiler.h"
+#include "Sleep.h"
+#include "ThreadPool.h"
+
+void stepSimulation(SimState& sim, float dt)
+{
+    PROFILE_SCOPE("stepSimulation");
+
+    // No workers: parallelFor runs inline on the caller
+    ThreadPool  inlinePool(1);
+    ThreadPool& pool = sim.pool ? *sim.pool : inlinePool;
+
+    BodyStore&       bodies  = sim.bodies;
+    StepScratch&     scratch = sim.scratch;
+    FrameArena&      arena   = scratch.arena;
+    const SimParams& p       = sim.params;
+
+    // Last tick's transient lists go; O(1) unless it outgrew the block
+    arena.reset();
+
+    // Gravity + integrate awake bodies
+    {
+        PROFILE_SCOPE("integrate");
+        integrateAll(bodies, p.gravity, dt, pool);
+    }
+
+    // Detect: spatial hash → batched narrowphase, wake whatever a moving
+    // body ran into, then floor
+    {
+        PROFILE_SCOPE("pairs");
+        scratch.broadphase.build(bodies, pool, arena);
+    }
+    {
+        PROFILE_SCOPE("sweep");
+        scratch.continuous.clamp(bodies, scratch.broadphase, p, dt, arena);
+    }
+    {
+        PROFILE_SCOPE("narrowphase");
+        scratch.contacts = findSphereContacts(bodies, scratch.broadphase.pairs, arena);
+        wakeTouchedBodies(bodies, scratch.contacts, p, dt);
+    }
+    {
+        PROFILE_SCOPE("floor");
+        scratch.floorContacts = findFloorContacts(bodies, p.floorY, arena);
+    }
+
+    // Warm-started sequential impulses over all contacts at once
+    {
+        PROFILE_SCOPE("solve");
+        scratch.solver.solve(bodies, scratch.contacts, scratch.floorContacts, p, dt, pool,
+                             arena);
+        scratch.continuous.advance(bodies, scratch.broadphase, p, dt);
+    }
+    {
+        PROFILE_SCOPE("sleep");
+        sim.stats.awakeBodies = updateSleep(bodies, p, dt, pool);
+    }
+
+    sim.stats.pairsTested   = scratch.broadphase.pairsTested;
+    sim.stats.candidates    = scratch.broadphase.pairs.size();
+    sim.stats.contacts      = scratch.contacts.size();
+    sim.stats.floorContacts = scratch.floorContacts.size();
+    sim.stats.warmStarted   = scratch.solver.warmStarted;
+    sim.stats.sweptBodies   = scratch.continuous.fast.size();
+    sim.stats.sweepHits     = scratch.continuous.hits.size();
+    sim.stats.arenaBytes    = arena.used();
+}
@@ -0,0 +1,7 @@
+#pragma once
+#include "SimState.h"
+
+// One fixed physics tick: integrate → broadphase → sweep fast bodies →
+// narrowphase → floor → coloured contact solve → finish swept bodies.
+// No GL/GLFW; callable from headless tools.
+void stepSimulation(SimState& sim, float dt);
@@ -0,0 +1,55 @@
+#include "Sleep.h"
+
+#include <atomic>
+
+void wakeTouchedBodies(BodyStore& s, std::span<const Contact> contacts,
+                       const SimParams& params, float dt)
+{
+    const float     linear2  = params.sleepLinearSpeed  * params.sleepLinearSpeed;
+    const float     angular2 = params.sleepAngularSpeed * params.sleepAngularSpeed;
+    const glm::vec3 fall     = params.gravity * dt;  // already added this tick, even at rest
+
+    // Moving: above the thresholds last tick (timer is exactly 0 after that,
+    // or after a wake), or above them now apart from this tick's gravity
+    auto moving = [&](std::uint32_t i) {
+        if (!s.isAwake(i) || s.invMass[i] == 0.0f) return false;
+        if (s.sleepTimer[i] == 0.0f) return true;
+        const float vx = s.vx[i] - fall.x, vy = s.vy[i] - fall.y, vz = s.vz[i] - fall.z;
+        const float v2 = vx * vx + vy * vy + vz * vz;
+        const float w2 = s.wx[i] * s.wx[i] + s.wy[i] * s.wy[i] + s.wz[i] * s.wz[i];
+        return v2 >= linear2 || w2 >= angular2;
+    };
+
+    for (const Contact& c : contacts) {
+        if (!s.isAwake(c.a) && moving(c.b)) s.wake(c.a);
+        if (!s.isAwake(c.b) && moving(c.a)) s.wake(c.b);
+    }
+}
+
+std::size_t updateSleep(BodyStore& s, const SimParams& params, float dt, ThreadPool& pool)
+{
+    const float linear2  = params.sleepLinearSpeed  * params.sleepLinearSpeed;
+    const float angular2 = params.sleepAngularSpeed * params.sleepAngularSpeed;
+
+    std::atomic<std::size_t> awakeCount{0};
+    pool.parallelFor(s.size(), 4096, [&](std::size_t begin, std::size_t end) {
+        std::size_t count = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            if (!s.isAwake(i) || s.invMass[i] == 0.0f) continue;
+
+            float v2 = s.vx[i] * s.vx[i] + s.vy[i] * s.vy[i] + s.vz[i] * s.vz[i];
+            float w2 = s.wx[i] * s.wx[i] + s.wy[i] * s.wy[i] + s.wz[i] * s.wz[i];
+            s.sleepTimer[i] = (v2 < linear2 && w2 < angular2) ? s.sleepTimer[i] + dt : 0.0f;
+
+            if (params.allowSleep && s.sleepTimer[i] >= params.sleepTime) {
+                s.awake[i] = 0.0f;
+                s.setVelocity(i, glm::vec3{0.0f});
+                s.setAngularVelocity(i, glm::vec3{0.0f});
+            } else {
+                ++count;
+            }
+        }
+        awakeCount += count;
+    });
+    return awakeCount;
+}
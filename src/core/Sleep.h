@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include "BodyStore.h"
+#include "Narrowphase.h"
+#include "SimParams.h"
+#include "ThreadPool.h"
+
+// Body sleeping, per body (no islands).
+// A body that stays below both velocity thresholds for sleepTime seconds is
+// put to sleep: integration, floor tests and broadphase queries skip it, and
+// the solver treats it as static. Forces (BodyStore::applyForce) wake it.
+
+// Wakes sleeping bodies touched by a moving body: one above the sleep
+// thresholds last tick or, leaving out this tick's gravity, now. A resting
+// neighbour leaves them asleep, so a settled pile doesn't keep waking itself
+// one body at a time. Runs after integration, before the solve.
+void wakeTouchedBodies(BodyStore& bodies, std::span<const Contact> contacts,
+                       const SimParams& params, float dt);
+
+// Advances sleep timers after the solve and puts still bodies to sleep.
+// Returns the number of dynamic bodies left awake.
+std::size_t updateSleep(BodyStore& bodies, const SimParams& params, float dt, ThreadPool& pool);
@@ -0,0 +1,128 @@
+#include "Snapshot.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+constexpr char kMagic[8] = {'3', 'D', 'S', 'N', 'A', 'P', '\0', '\0'};
+
+std::uint64_t alignUp(std::uint64_t bytes)
+{
+    return (bytes + kSnapshotAlignment - 1) & ~std::uint64_t{kSnapshotAlignment - 1};
+}
+
+std::uint32_t bodyArrayCount(const BodyStore& bodies)
+{
+    std::uint32_t count = 0;
+    bodies.forEachArray([&](const std::vector<float>&) { ++count; });
+    return count;
+}
+
+} // namespace
+
+// ---------- read ----------
+
+bool openSnapshot(const void* data, std::size_t size, SnapshotView& out)
+{
+    const auto* header = static_cast<const SnapshotHeader*>(data);
+
+    if (size < sizeof(SnapshotHeader) || std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0) {
+        std::fprintf(stderr, "Snapshot: not a snapshot file\n");
+        return false;
+    }
+    if (header->endianTag != kSnapshotEndianTag) {
+        std::fprintf(stderr, "Snapshot: written with a different byte order\n");
+        return false;
+    }
+    if (header->version != kSnapshotVersion) {
+        std::fprintf(stderr, "Snapshot: version %u, expected %u\n",
+                     header->version, kSnapshotVersion);
+        return false;
+    }
+
+    const std::uint32_t arrays = bodyArrayCount(BodyStore{});
+    if (header->arrayCount != arrays || header->headerSize < sizeof(SnapshotHeader) ||
+        header->headerSize % kSnapshotAlignment != 0) {
+        std::fprintf(stderr, "Snapshot: unexpected body layout\n");
+        return false;
+    }
+    // Bound bodyCount by the file first, so the stride and size below can't wrap
+    if (size < header->headerSize ||
+        header->bodyCount > (size - header->headerSize) / arrays / sizeof(float)) {
+        std::fprintf(stderr, "Snapshot: truncated (%zu bytes)\n", size);
+        return false;
+    }
+    if (header->arrayStride != alignUp(header->bodyCount * sizeof(float))) {
+        std::fprintf(stderr, "Snapshot: unexpected body layout\n");
+        return false;
+    }
+    if (size < header->headerSize + header->arrayStride * arrays) {
+        std::fprintf(stderr, "Snapshot: truncated (%zu bytes)\n", size);
+        return false;
+    }
+
+    out.header = header;
+    out.base   = static_cast<const unsigned char*>(data);
+    return true;
+}
+
+void loadSnapshot(const SnapshotView& view, SimState& sim)
+{
+    const std::size_t n = view.bodyCount();
+
+    std::size_t k = 0;
+    sim.bodies.forEachArray([&](std::vector<float>& a) {
+        const float* src = view.array(k++);
+        a.assign(src, src + n);
+    });
+
+    const SnapshotHeader& h = *view.header;
+    sim.camera.position = {h.cameraPosition[0], h.cameraPosition[1], h.cameraPosition[2]};
+    sim.camera.yaw      = h.cameraYaw;
+    sim.camera.pitch    = h.cameraPitch;
+    sim.camera.updateVectors();
+
+    sim.scratch.solver.reset();
+    sim.stats = {};
+}
+
+// ---------- write ----------
+
+bool writeSnapshot(const char* path, const SimState& sim)
+{
+    std::FILE* f = std::fopen(path, "wb");
+    if (!f) {
+        std::fprintf(stderr, "Snapshot: cannot open %s for writing\n", path);
+        return false;
+    }
+
+    const std::uint64_t n = sim.bodies.size();
+
+    SnapshotHeader h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version           = kSnapshotVersion;
+    h.headerSize        = static_cast<std::uint32_t>(alignUp(sizeof(SnapshotHeader)));
+    h.bodyCount         = n;
+    h.arrayStride       = alignUp(n * sizeof(float));
+    h.arrayCount        = bodyArrayCount(sim.bodies);
+    h.endianTag         = kSnapshotEndianTag;
+    h.cameraPosition[0] = sim.camera.position.x;
+    h.cameraPosition[1] = sim.camera.position.y;
+    h.cameraPosition[2] = sim.camera.position.z;
+    h.cameraYaw         = sim.camera.yaw;
+    h.cameraPitch       = sim.camera.pitch;
+
+    static const unsigned char zeros[kSnapshotAlignment] = {};
+    const std::size_t padding = static_cast<std::size_t>(h.arrayStride - n * sizeof(float));
+
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+    sim.bodies.forEachArray([&](const std::vector<float>& a) {
+        ok = ok && std::fwrite(a.data(), sizeof(float), a.size(), f) == a.size();
+        ok = ok && std::fwrite(zeros, 1, padding, f) == padding;
+    });
+    ok = (std::fclose(f) == 0) && ok;
+
+    if (!ok) std::fprintf(stderr, "Snapshot: write to %s failed\n", path);
+    return ok;
+}
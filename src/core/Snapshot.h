@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "SimState.h"
+
+// Binary SimState snapshot: camera + every BodyStore array, laid out so a
+// memory-mapped file can be used in place or bulk-copied with no parsing.
+//
+//   [SnapshotHeader, 64 bytes]
+//   [array 0: bodyCount floats, zero-padded to arrayStride]
+//   [array 1] ...                BodyStore::forEachArray order
+//
+// Arrays start on 64-byte boundaries. Little-endian only; any change to the
+// BodyStore layout bumps kSnapshotVersion.
+
+constexpr std::uint32_t kSnapshotVersion   = 1;
+constexpr std::uint32_t kSnapshotAlignment = 64;
+constexpr std::uint32_t kSnapshotEndianTag = 0x01020304u;
+
+struct SnapshotHeader {
+    char          magic[8];        // "3DSNAP\0\0"
+    std::uint32_t version;
+    std::uint32_t headerSize;      // offset of array 0
+    std::uint64_t bodyCount;
+    std::uint64_t arrayStride;     // bytes between array starts
+    std::uint32_t arrayCount;
+    std::uint32_t endianTag;       // kSnapshotEndianTag as written
+    float         cameraPosition[3];
+    float         cameraYaw;
+    float         cameraPitch;
+    std::uint32_t reserved;
+};
+static_assert(sizeof(SnapshotHeader) == 64, "snapshot header layout");
+
+// Validated, non-owning view of snapshot bytes (e.g. a mapped file)
+struct SnapshotView {
+    const SnapshotHeader* header{nullptr};
+    const unsigned char*  base{nullptr};
+
+    std::size_t  bodyCount() const { return static_cast<std::size_t>(header->bodyCount); }
+
+    // k in BodyStore::forEachArray order; bodyCount() floats
+    const float* array(std::size_t k) const
+    {
+        return reinterpret_cast<const float*>(base + header->headerSize + k * header->arrayStride);
+    }
+};
+
+// Checks magic, version, layout and size; prints the reason on failure.
+bool openSnapshot(const void* data, std::size_t size, SnapshotView& out);
+
+// One memcpy per array into sim.bodies; restores the camera and clears
+// per-tick state (contact cache, stats).
+void loadSnapshot(const SnapshotView& view, SimState& sim);
+
+bool writeSnapshot(const char* path, const SimState& sim);
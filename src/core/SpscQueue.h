@@ -0,0 +1,50 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+// Lock-free single-producer / single-consumer ring of Capacity items.
+// push() never waits: it fails when the ring is full. Each side caches the
+// other's index and only reloads it when the ring looks full (producer) or
+// empty (consumer), so the two cache lines rarely bounce.
+template <class T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "items are copied in and out of the ring");
+
+public:
+    // ---------- producer ----------
+    bool push(const T& item)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_headCache == Capacity) {
+            m_headCache = m_head.load(std::memory_order_acquire);
+            if (tail - m_headCache == Capacity) return false;
+        }
+        m_items[tail & (Capacity - 1)] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // ---------- consumer ----------
+    // Oldest item, or nullptr when empty; stays valid until pop()
+    const T* front()
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tailCache) {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tailCache) return nullptr;
+        }
+        return &m_items[head & (Capacity - 1)];
+    }
+
+    // Only after front() returned an item
+    void pop() { m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+private:
+    alignas(64) std::atomic<std::size_t> m_head{0};  // written by the consumer
+    std::size_t                          m_tailCache{0};
+    alignas(64) std::atomic<std::size_t> m_tail{0};  // written by the producer
+    std::size_t                          m_headCache{0};
+    alignas(64) T                        m_items[Capacity];
+};
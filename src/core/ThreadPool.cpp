@@ -0,0 +1,106 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    m_workers.reserve(threadCount - 1);
+    for (unsigned i = 1; i < threadCount; ++i)
+        m_workers.emplace_back([this] { workerLoop(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& t : m_workers) t.join();
+}
+
+void ThreadPool::run(RangeFn fn, void* ctx, std::size_t count, std::size_t grain)
+{
+    if (count == 0) return;
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t chunks = (count + grain - 1) / grain;
+
+    if (m_workers.empty() || chunks == 1) {
+        fn(ctx, 0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fn    = fn;
+        m_ctx   = ctx;
+        m_count = count;
+        m_grain = grain;
+        m_nextChunk.store(0, std::memory_order_relaxed);
+        m_chunksLeft.store(chunks, std::memory_order_relaxed);
+        m_jobOpen = true;
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    drain(fn, ctx, count, grain);
+
+    // Wait for the last chunk and for every worker that joined to leave
+    // drain(), then close the job under the same lock: a worker woken for
+    // it that only gets the mutex now must not pick up fn/ctx, which die
+    // with the caller's parallelFor frame.
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] {
+        return m_chunksLeft.load(std::memory_order_acquire) == 0 && m_active == 0;
+    });
+    m_jobOpen = false;
+}
+
+void ThreadPool::drain(RangeFn fn, void* ctx, std::size_t count, std::size_t grain)
+{
+    const std::size_t chunks = (count + grain - 1) / grain;
+    for (;;) {
+        std::size_t c = m_nextChunk.fetch_add(1, std::memory_order_relaxed);
+        if (c >= chunks) return;
+
+        std::size_t begin = c * grain;
+        fn(ctx, begin, std::min(begin + grain, count));
+
+        if (m_chunksLeft.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_done.notify_all();
+        }
+    }
+}
+
+void ThreadPool::workerLoop()
+{
+    std::uint64_t seen = 0;
+    for (;;) {
+        RangeFn     fn;
+        void*       ctx;
+        std::size_t count, grain;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+            if (m_stop) return;
+            seen = m_generation;
+            if (!m_jobOpen) continue;  // finished before this worker woke
+
+            fn    = m_fn;
+            ctx   = m_ctx;
+            count = m_count;
+            grain = m_grain;
+            ++m_active;
+        }
+
+        drain(fn, ctx, count, grain);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_active;
+        if (m_active == 0) m_done.notify_all();
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops.
+// parallelFor() splits [0, count) into grain-sized chunks, the calling thread
+// works alongside the pool and the call returns once every chunk is done.
+// Work too small for two chunks runs inline with no synchronization.
+class ThreadPool {
+public:
+    // threadCount includes the caller; 0 = hardware_concurrency()
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned threadCount() const { return static_cast<unsigned>(m_workers.size()) + 1; }
+
+    // fn(begin, end) for each chunk
+    template <class F>
+    void parallelFor(std::size_t count, std::size_t grain, F fn)
+    {
+        run([](void* ctx, std::size_t b, std::size_t e) { (*static_cast<F*>(ctx))(b, e); },
+            &fn, count, grain);
+    }
+
+private:
+    using RangeFn = void (*)(void*, std::size_t, std::size_t);
+
+    void run(RangeFn fn, void* ctx, std::size_t count, std::size_t grain);
+    void workerLoop();
+    void drain(RangeFn fn, void* ctx, std::size_t count, std::size_t grain);
+
+    std::vector<std::thread> m_workers;
+    std::mutex               m_mutex;
+    std::condition_variable  m_wake;
+    std::condition_variable  m_done;
+
+    // Current job; written under m_mutex while no worker is active. Workers
+    // only join while m_jobOpen, which run() clears once the job is done.
+    RangeFn                  m_fn{nullptr};
+    void*                    m_ctx{nullptr};
+    std::size_t              m_count{0};
+    std::size_t              m_grain{1};
+    std::uint64_t            m_generation{0};
+    unsigned                 m_active{0};
+    bool                     m_jobOpen{false};
+    bool                     m_stop{false};
+
+    std::atomic<std::size_t> m_nextChunk{0};
+    std::atomic<std::size_t> m_chunksLeft{0};
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include <atomic>
+
+// Lock-free single-writer / single-reader triple buffer.
+// The writer fills writeBuffer() and publish()es it; the reader calls
+// update() to take the newest published slot and reads readBuffer() until
+// its next update(). Neither side ever waits; the reader just skips
+// slots published in between.
+template <class T>
+class TripleBuffer {
+public:
+    // ---------- writer ----------
+    T&   writeBuffer() { return m_slots[m_write]; }
+    void publish()
+    {
+        m_write = m_middle.exchange(m_write | kFresh, std::memory_order_acq_rel) & kIndex;
+    }
+
+    // ---------- reader ----------
+    // True if a newer slot was swapped in
+    bool update()
+    {
+        if (!(m_middle.load(std::memory_order_relaxed) & kFresh)) return false;
+        m_read = m_middle.exchange(m_read, std::memory_order_acq_rel) & kIndex;
+        return true;
+    }
+    const T& readBuffer() const { return m_slots[m_read]; }
+
+private:
+    static constexpr unsigned kIndex = 3;
+    static constexpr unsigned kFresh = 4;  // middle slot not yet taken
+
+    T                     m_slots[3];
+    unsigned              m_write{0};
+    unsigned              m_read{1};
+    std::atomic<unsigned> m_middle{2};
+};
@@ -0,0 +1,58 @@
+#include "WorldBatch.h"
+#include "Profiler.h"
+#include "Simulation.h"
+
+static void measureEnergy(const SimState& sim, WorldResult& out)
+{
+    const BodyStore& b = sim.bodies;
+    const glm::vec3  g = sim.params.gravity;
+
+    double kinetic = 0.0, potential = 0.0;
+    for (std::size_t i = 0; i < b.size(); ++i) {
+        if (b.invMass[i] == 0.0f) continue;
+        const double m  = 1.0 / b.invMass[i];
+        const double v2 = b.vx[i] * b.vx[i] + b.vy[i] * b.vy[i] + b.vz[i] * b.vz[i];
+        const double w2 = b.wx[i] * b.wx[i] + b.wy[i] * b.wy[i] + b.wz[i] * b.wz[i];
+        kinetic += 0.5 * m * v2;
+        if (b.invInertia[i] != 0.0f) kinetic += 0.5 * w2 / b.invInertia[i];
+        // -g·(p - floor): height along gravity above the floor plane
+        potential -= m * (g.x * b.px[i] + g.y * (b.py[i] - sim.params.floorY) + g.z * b.pz[i]);
+    }
+    out.kineticEnergy   = kinetic;
+    out.potentialEnergy = potential;
+}
+
+SimState& WorldBatch::add()
+{
+    m_worlds.push_back(std::make_unique<SimState>());
+    m_results.emplace_back();
+    return *m_worlds.back();
+}
+
+void WorldBatch::step(ThreadPool& pool, float dt, int ticks)
+{
+    PROFILE_SCOPE("WorldBatch::step");
+
+    // One tick of every world per parallelFor, so the batch advances in
+    // lockstep. Each world steps single-threaded inside its chunk; its own
+    // pool pointer is set aside for the call and put back afterwards.
+    for (int t = 0; t < ticks; ++t) {
+        const bool last = t + 1 == ticks;
+        pool.parallelFor(m_worlds.size(), 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t w = begin; w < end; ++w) {
+                SimState&    sim = *m_worlds[w];
+                WorldResult& r   = m_results[w];
+
+                ThreadPool* const own = sim.pool;
+                sim.pool = nullptr;
+                stepSimulation(sim, dt);
+                sim.pool = own;
+
+                ++r.ticks;
+                if (r.settleTime < 0.0f && sim.stats.awakeBodies == 0)
+                    r.settleTime = static_cast<float>(r.ticks) * dt;
+                if (last) measureEnergy(sim, r);
+            }
+        });
+    }
+}
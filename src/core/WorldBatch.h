@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "SimState.h"
+#include "ThreadPool.h"
+
+// Outcome of one world in a WorldBatch, as of the last step()
+struct WorldResult {
+    std::uint64_t ticks{0};
+    float         settleTime{-1.0f};     // s until every body first slept; < 0 = not yet
+    double        kineticEnergy{0.0};    // J, linear + angular
+    double        potentialEnergy{0.0};  // J, against gravity, relative to floorY
+};
+
+// Many independent worlds stepped together, headless.
+// Each tick, worlds are spread across the pool one per chunk and each steps
+// on a single thread (its own pool is not used), so a sweep of many small
+// scenes keeps every core busy with no locking inside a world. All worlds
+// finish tick t before any starts tick t + 1.
+class WorldBatch {
+public:
+    // New default world; fill in params and bodies before the first step()
+    SimState& add();
+
+    std::size_t        size() const { return m_worlds.size(); }
+    SimState&          world(std::size_t i) { return *m_worlds[i]; }
+    const WorldResult& result(std::size_t i) const { return m_results[i]; }
+
+    // `ticks` fixed steps of every world in lockstep, then refreshes the results;
+    // each world's sim.pool is left as it was
+    void step(ThreadPool& pool, float dt, int ticks);
+
+private:
+    std::vector<std::unique_ptr<SimState>> m_worlds;  // stable addresses for add()
+    std::vector<WorldResult>               m_results;
+};
@@ -2,18 +2,36 @@
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtc/quaternion.hpp>
 
 #include "core/SimState.h"
+#include "core/Culling.h"
 #include "core/Physics.h"
+#include "core/Profiler.h"
+#include "core/SimThread.h"
+#include "core/Snapshot.h"
+#include "core/ThreadPool.h"
+#include "platform/MappedFile.h"
 #include "platform/Window.h"
 #include "platform/Input.h"
+#include "rendering/AssetLoader.h"
+#include "rendering/GeometryArena.h"
+#include "rendering/GpuProfiler.h"
+#include "rendering/InstanceBuffer.h"
 #include "rendering/Shader.h"
+#include "rendering/ShaderLibrary.h"
 #include "rendering/Mesh.h"
+#include "rendering/MeshOptimize.h"
+#include "rendering/UniformBuffer.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <string>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
 
 // Resolve the shader directory from argv[0]
 static std::string exeDir(const char* argv0)
@@ -25,13 +43,106 @@ static std::string exeDir(const char* argv0)
     return ".";
 }
 
-int main(int /*argc*/, char* argv[])
+// Body i between the last two ticks: lerp position, nlerp orientation
+static InstanceData interpolatedInstance(const RenderState& s, std::uint32_t i, float alpha)
 {
+    const float b = 1.0f - alpha;
+
+    // Shortest arc: flip the older quaternion into the same hemisphere
+    const float dot = s.prevQx[i] * s.qx[i] + s.prevQy[i] * s.qy[i] +
+                      s.prevQz[i] * s.qz[i] + s.prevQw[i] * s.qw[i];
+    const float sb  = dot < 0.0f ? -b : b;
+    const float qx  = s.prevQx[i] * sb + s.qx[i] * alpha;
+    const float qy  = s.prevQy[i] * sb + s.qy[i] * alpha;
+    const float qz  = s.prevQz[i] * sb + s.qz[i] * alpha;
+    const float qw  = s.prevQw[i] * sb + s.qw[i] * alpha;
+    const float inv = 1.0f / std::sqrt(qx * qx + qy * qy + qz * qz + qw * qw);
+
+    return {s.prevPx[i] * b + s.px[i] * alpha,
+            s.prevPy[i] * b + s.py[i] * alpha,
+            s.prevPz[i] * b + s.pz[i] * alpha,
+            s.radius[i] / Mesh::kSphereRadius,
+            qx * inv, qy * inv, qz * inv, qw * inv};
+}
+
+// Shared geometry budget: 12 MiB of vertices, 8 MiB of 16-bit indices,
+// 8 MiB of 32-bit ones (big --mesh files)
+constexpr std::size_t kArenaVertices    = std::size_t{1} << 20;
+constexpr std::size_t kArenaIndices     = std::size_t{1} << 22;
+constexpr std::size_t kArenaWideIndices = std::size_t{1} << 21;
+
+// Sphere LOD k, finest first: an icosphere, cache- and fetch-ordered
+// (vertex work per triangle is the ACMR)
+static MeshGeometry sphereLodGeometry(int k)
+{
+    static const int subdivisions[kLodLevels] = {3, 2, 1, 0};
+
+    MeshGeometry            g  = Mesh::icosphereGeometry(subdivisions[k]);
+    const MeshOptimizeStats st = optimizeMesh(g);
+    std::printf("Sphere LOD %d: %zu vertices, %zu triangles, ACMR %.3f -> %.3f\n",
+                k, g.vertices.size(), g.indices.size() / 3, st.acmrBefore, st.acmrAfter);
+    return g;
+}
+
+int main(int argc, char* argv[])
+{
+    using Clock = std::chrono::steady_clock;
+    const auto startTime = Clock::now();
+
     const std::string dir = exeDir(argv[0]);
 
+    // 3d-test [--snapshot FILE] [--trace FILE] [--mesh FILE] [--write-mesh FILE] [--unlit]
+    //         [--hz H] [--input-thread]
+    const char* snapshotPath  = nullptr;
+    const char* tracePath     = nullptr;
+    const char* meshPath      = nullptr;
+    const char* writeMeshPath = nullptr;
+    bool        unlit         = false;
+    float       hz            = 60.0f;  // physics ticks per second
+    bool        inputThread   = false;  // render off the main thread, which waits on events
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc) {
+            snapshotPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--mesh") == 0 && i + 1 < argc) {
+            meshPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--write-mesh") == 0 && i + 1 < argc) {
+            writeMeshPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--unlit") == 0) {
+            unlit = true;
+        } else if (std::strcmp(argv[i], "--hz") == 0 && i + 1 < argc
+                   && std::atof(argv[i + 1]) > 0.0) {
+            hz = static_cast<float>(std::atof(argv[++i]));
+        } else if (std::strcmp(argv[i], "--input-thread") == 0) {
+            inputThread = true;
+        } else {
+            std::fprintf(stderr, "usage: %s [--snapshot FILE] [--trace FILE]"
+                                 " [--mesh FILE] [--write-mesh FILE] [--unlit] [--hz H]"
+                                 " [--input-thread]\n",
+                         argv[0]);
+            return 1;
+        }
+    }
+
+    // Finest sphere LOD as a mesh file, e.g. to try --mesh with; no window needed
+    if (writeMeshPath)
+        return writeMeshFile(writeMeshPath, sphereLodGeometry(0)) ? 0 : 1;
+
+    // Chrome trace of every frame, written on exit
+    profilerSetThreadName("main");
+    profilerSetEnabled(tracePath != nullptr);
+
     Window window(1280, 720, "3d-test");
-    InputState input;
-    inputAttach(window.handle(), input);
+    // Every event goes to both consumers, timestamped: the render loop
+    // drains its queue per frame, the simulation per tick window
+    InputSource inputSource;
+    InputQueue  renderInput;
+    InputQueue  simInput;
+    InputState  input;  // render loop's view
+    inputAddQueue(inputSource, renderInput);
+    inputAddQueue(inputSource, simInput);
+    inputAttach(window.handle(), inputSource);
 
     SimState sim;
     sim.camera.updateVectors();
@@ -49,15 +160,72 @@ int main(int /*argc*/, char* argv[])
         { 1.5f, 6.0f, -1.5f},
         {-1.5f, 4.0f,  1.0f},
     };
-    sim.bodies.reserve(std::size(spawnPts));
-    for (const auto& p : spawnPts)
-        sim.bodies.push_back(makeSphere(p, sphR, sphMass));
+    if (snapshotPath) {
+        // Bodies + camera straight from the mapped file
+        MappedFile   file;
+        SnapshotView view;
+        if (!file.open(snapshotPath) || !openSnapshot(file.data(), file.size(), view))
+            std::exit(1);
+        loadSnapshot(view, sim);
+    } else {
+        sim.bodies.reserve(std::size(spawnPts));
+        for (const auto& p : spawnPts)
+            sim.bodies.push_back(makeSphere(p, sphR, sphMass));
+    }
+
+    // Pick the cheapest object shader variant this scene allows
+    std::vector<std::string> features;
+    const bool rigid = std::all_of(sim.bodies.radius.begin(), sim.bodies.radius.end(),
+                                   [](float r) { return r == Mesh::kSphereRadius; });
+    if (rigid) features.push_back("RIGID_TRANSFORM_ONLY");  // the prop has scale 1 too
+    if (unlit) features.push_back("NO_LIGHTING");
+
+    ShaderLibrary shaders(dir + "/shader-cache");
+    Shader&       shader = shaders.get(dir + "/shaders/object.vert",
+                                       dir + "/shaders/object.frag", features);
+
+    // Camera + lighting block, bound once for every program
+    UniformBuffer frameUniforms(sizeof(FrameUniforms));
+    frameUniforms.bind(kFrameUniformBinding);
+
+    // Every mesh in one arena. Meshes arrive while frames are already
+    // running, so it gets a fixed budget rather than an exact size.
+    GeometryArena arena(kArenaVertices, kArenaIndices, kArenaWideIndices);
+
+    // Generated, read and uploaded off the main thread; each one is drawn
+    // from the frame its upload fence signals
+    AssetLoader loader(window.createSharedContext(), arena);
+
+    // Static prop at the origin: the cube, or a mesh file uploaded from its mapping.
+    // A file that fails to load or fit falls back to the cube.
+    AssetId prop = meshPath ? loader.loadMeshFile(meshPath)
+                            : loader.loadMesh(Mesh::cubeGeometry);
+    bool propFallback = !meshPath;
+
+    // Bodies are bucketed per frame by distance into the sphere LODs
+    AssetId sphereLod[kLodLevels];
+    for (int k = 0; k < kLodLevels; ++k)
+        sphereLod[k] = loader.loadMesh([k] { return sphereLodGeometry(k); });
+
+    // LOD k, or the nearest one already loaded (coarser first); -1 if none
+    auto loadedLod = [&](int k) {
+        for (int d = 0; d < kLodLevels; ++d) {
+            if (k + d < kLodLevels && loader.ready(sphereLod[k + d])) return k + d;
+            if (k - d >= 0 && loader.ready(sphereLod[k - d])) return k - d;
+        }
+        return -1;
+    };
+
+    // One multi-draw per frame: prop + one command per non-empty LOD bucket
+    DrawList drawList;
 
-    Shader shader(dir + "/shaders/object.vert",
-                  dir + "/shaders/object.frag");
+    LodParams  lodParams;
+    CullResult culled;
 
-    Mesh cube   = Mesh::buildCube();
-    Mesh sphere = Mesh::buildSphere(16, 16);
+    // Per-frame transforms: slot 0 = cube, 1.. = bodies. Triple-buffered ring.
+    InstanceBuffer instances;
+
+    GpuProfiler gpuProfiler;
 
     // Lighting constants
     const glm::vec3 lightDir    = glm::normalize(glm::vec3(0.4f, -1.0f, 0.3f));
@@ -66,101 +234,173 @@ int main(int /*argc*/, char* argv[])
     const float     moveSpeed   = 5.0f;
     const float     mouseSens   = 0.1f;
 
-    const glm::vec3 gravity    {0.0f, -9.81f, 0.0f};
-    const float     restitution = 0.6f;
-    const float     floorY      = 0.0f;
+    sim.params.gravity     = {0.0f, -9.81f, 0.0f};
+    sim.params.restitution = 0.6f;
+    sim.params.floorY      = 0.0f;
 
-    constexpr float FIXED_DT  = 1.0f / 120.0f;  // 120 Hz sim
-    float           accumulator = 0.0f;
+    // Physics workers; the simulation thread joins in, one core stays with rendering
+    const unsigned cores = std::thread::hardware_concurrency();
+    ThreadPool     pool(cores > 1 ? cores - 1 : 1);
+    sim.pool = &pool;
 
-    using Clock = std::chrono::steady_clock;
-    auto prev = Clock::now();
-
-    while (!window.shouldClose()) {
-        inputBeginFrame(input);
-        window.pollEvents();
-
-        // Delta time, capped at 50ms to prevent spiral of death
-        auto now = Clock::now();
-        float frameTime = std::chrono::duration<float>(now - prev).count();
-        prev = now;
-        if (frameTime > 0.05f) frameTime = 0.05f;
-        accumulator += frameTime;
-
-        // ESC → close
-        if (inputKey(input, GLFW_KEY_ESCAPE))
-            glfwSetWindowShouldClose(window.handle(), GLFW_TRUE);
-
-        // Mouse: apply once per render frame (it's a delta, not a rate)
-        sim.camera.processMouseDelta(input.mouseDeltaX, input.mouseDeltaY, mouseSens);
-
-        // Fixed-rate physics tick
-        while (accumulator >= FIXED_DT) {
-            sim.camera.processMovement(
-                inputKey(input, GLFW_KEY_W),
-                inputKey(input, GLFW_KEY_S),
-                inputKey(input, GLFW_KEY_A),
-                inputKey(input, GLFW_KEY_D),
-                inputKey(input, GLFW_KEY_E),
-                inputKey(input, GLFW_KEY_Q),
-                moveSpeed, FIXED_DT);
-
-            // Gravity + integrate all bodies
-            for (auto& body : sim.bodies) {
-                body.applyForce(gravity / body.invMass);
-                integrate(body, FIXED_DT);
+    // Continuous collision keeps fast bodies from tunnelling at 30 Hz and below
+    const float FIXED_DT = 1.0f / hz;
+    SimThread       simThread;
+
+    // The camera moves on the simulation thread, once per tick, from the
+    // events stamped within that tick; the renderer blends the last two.
+    // Mouse look is a delta, so summing it per tick loses nothing.
+    simThread.setInput(simInput, [&](SimState& s, const InputState& in) {
+        s.camera.processMouseDelta(in.mouseDeltaX, in.mouseDeltaY, mouseSens);
+        s.camera.processMovement(
+            inputKey(in, GLFW_KEY_W),
+            inputKey(in, GLFW_KEY_S),
+            inputKey(in, GLFW_KEY_A),
+            inputKey(in, GLFW_KEY_D),
+            inputKey(in, GLFW_KEY_E),
+            inputKey(in, GLFW_KEY_Q),
+            moveSpeed, FIXED_DT);
+    });
+    simThread.start(sim, FIXED_DT);
+
+    bool firstFrame  = true;
+    bool assetsReady = false;
+
+    auto renderLoop = [&] {
+        while (!window.shouldClose()) {
+            PROFILE_SCOPE("frame");
+
+            {
+                PROFILE_SCOPE("input poll");
+                if (!inputThread) window.pollEvents();
+                inputBeginFrame(input);
+                inputDrain(renderInput, input);
             }
 
-            // Floor resolution
-            for (auto& body : sim.bodies)
-                resolveFloor(body, floorY, restitution);
+            {
+                PROFILE_SCOPE("asset poll");
+                loader.poll();
+                if (loader.failed(prop) && !propFallback) {
+                    std::fprintf(stderr, "Drawing the cube in place of %s\n", meshPath);
+                    prop         = loader.loadMesh(Mesh::cubeGeometry);
+                    propFallback = true;
+                }
+                if (!assetsReady && loader.pending() == 0) {
+                    assetsReady = true;
+                    std::printf("Assets ready after %.1f ms\n",
+                                std::chrono::duration<double, std::milli>(Clock::now() - startTime).count());
+                }
+            }
 
-            // Sphere-sphere pairs (O(N²), N=8 → 28 pairs/tick)
-            for (std::size_t i = 0; i < sim.bodies.size(); ++i)
-                for (std::size_t j = i + 1; j < sim.bodies.size(); ++j)
-                    resolveSpherePair(sim.bodies[i], sim.bodies[j], restitution);
+            const auto now = Clock::now();
 
-            accumulator -= FIXED_DT;
-        }
+            // ESC → close
+            if (inputKey(input, GLFW_KEY_ESCAPE)) {
+                glfwSetWindowShouldClose(window.handle(), GLFW_TRUE);
+                glfwPostEmptyEvent();  // wakes the event wait with --input-thread
+            }
 
-        // Render
-        glClearColor(0.1f, 0.1f, 0.15f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        glViewport(0, 0, window.width(), window.height());
-
-        float aspect = static_cast<float>(window.width()) / static_cast<float>(window.height());
-        glm::mat4 proj = glm::perspective(glm::radians(60.0f), aspect, 0.1f, 100.0f);
-        glm::mat4 view = sim.camera.viewMatrix();
-
-        shader.use();
-        shader.setMat4("view",       view);
-        shader.setMat4("projection", proj);
-        shader.setVec3("lightDir",   lightDir);
-        shader.setVec3("lightColor", lightColor);
-        shader.setFloat("ambientStrength", ambient);
-
-        // Cube at origin
-        {
-            glm::mat4 model = glm::mat4(1.0f);
-            shader.setMat4("model",       model);
-            shader.setVec3("objectColor", glm::vec3(0.8f, 0.4f, 0.2f));
-            cube.draw();
-        }
+            // Newest tick from the simulation thread, blended with the one before
+            const RenderState& state  = simThread.latest();
+            const float        alpha  = state.alpha(now, FIXED_DT);
+            const Camera       camera = state.blendCamera(alpha);
+
+            // Render
+            {
+                GPU_PROFILE_SCOPE(gpuProfiler, "clear");
+                glClearColor(0.1f, 0.1f, 0.15f, 1.0f);
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            }
+            glViewport(0, 0, window.width(), window.height());
+
+            float aspect = static_cast<float>(window.width()) / static_cast<float>(window.height());
+            glm::mat4 proj = glm::perspective(glm::radians(60.0f), aspect, 0.1f, 100.0f);
+            glm::mat4 view = camera.viewMatrix();
+
+            {
+                PROFILE_SCOPE("uniform upload");
+                const FrameUniforms frame{view, proj, glm::vec4(lightDir, 0.0f),
+                                          glm::vec4(lightColor, ambient)};
+                frameUniforms.update(&frame, sizeof(frame));
+            }
 
-        // Spheres — one Mesh, drawn per body
-        shader.setVec3("objectColor", glm::vec3(0.3f, 0.6f, 0.9f));
-        for (const auto& body : sim.bodies) {
-            glm::mat4 model = glm::translate(glm::mat4(1.0f), body.position)
-                            * glm::mat4_cast(body.orientation);
-            shader.setMat4("model", model);
-            sphere.draw();
+            shader.use();
+
+            // Cull against the frustum, bucket survivors by LOD
+            {
+                PROFILE_SCOPE("cull");
+                cullSpheres(state.px.data(), state.py.data(), state.pz.data(), state.radius.data(),
+                            state.size(), extractFrustum(proj * view), camera.position,
+                            lodParams, culled);
+            }
+
+            // Stream interpolated transforms, in bucket order, straight into mapped memory
+            {
+                PROFILE_SCOPE("instance upload");
+                InstanceData* slots = instances.map(culled.visible() + 1);
+                slots[0] = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+                for (std::uint32_t k = 0; k < culled.visible(); ++k)
+                    slots[k + 1] = interpolatedInstance(state, culled.order[k], alpha);
+                instances.bind(0);
+            }
+
+            {
+                PROFILE_SCOPE("draws");
+                GPU_PROFILE_SCOPE(gpuProfiler, "draws");
+
+                // Instance slot 0 = prop; bucket k starts at slot 1 + first[k]
+                drawList.clear();
+                if (loader.ready(prop))
+                    drawList.add(loader.mesh(prop), 1, 0, glm::vec3(0.8f, 0.4f, 0.2f));
+                for (int k = 0; k < kLodLevels; ++k) {
+                    const int lod = loadedLod(k);
+                    if (lod < 0) continue;
+                    drawList.add(loader.mesh(sphereLod[lod]), culled.count(k), 1 + culled.first[k],
+                                 glm::vec3(0.3f, 0.6f, 0.9f));
+                }
+
+                drawList.submit(arena, kDrawDataBinding);
+            }
+            instances.endFrame();
+            drawList.endFrame();
+            gpuProfiler.endFrame();
+
+            {
+                PROFILE_SCOPE("swapBuffers");
+                window.swapBuffers();
+            }
+
+            if (firstFrame) {
+                firstFrame = false;
+                std::printf("First frame after %.1f ms\n",
+                            std::chrono::duration<double, std::milli>(Clock::now() - startTime).count());
+            }
         }
+    };
 
-        window.swapBuffers();
+    if (inputThread) {
+        // Callbacks fire as soon as the OS delivers an event rather than
+        // once per frame; GLFW only allows event processing on this thread
+        glfwMakeContextCurrent(nullptr);
+        std::thread render([&] {
+            profilerSetThreadName("render");
+            glfwMakeContextCurrent(window.handle());
+            renderLoop();
+            glfwMakeContextCurrent(nullptr);
+            glfwPostEmptyEvent();
+        });
+        while (!window.shouldClose())
+            glfwWaitEvents();
+        render.join();
+        glfwMakeContextCurrent(window.handle());  // GL objects are destroyed here
+    } else {
+        renderLoop();
     }
 
-    cube.destroy();
-    sphere.destroy();
+    simThread.stop();
+
+    if (tracePath)
+        profilerWriteTrace(tracePath);
 
     return 0;
 }
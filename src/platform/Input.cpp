@@ -1,34 +1,52 @@
 #include "Input.h"
 
+static_assert(GLFW_KEY_LAST < kInputKeyCount, "InputState must cover every GLFW key");
+
+static void pushEvent(InputSource& source, const InputEvent& e)
+{
+    for (int i = 0; i < source.queueCount; ++i)
+        if (!source.queues[i]->push(e)) ++source.dropped;
+}
+
 static void keyCallback(GLFWwindow* window, int key, int /*scancode*/, int action, int /*mods*/)
 {
-    auto* state = static_cast<InputState*>(glfwGetWindowUserPointer(window));
-    if (!state) return;
+    auto* source = static_cast<InputSource*>(glfwGetWindowUserPointer(window));
+    if (!source) return;
     if (key < 0 || key > GLFW_KEY_LAST) return;
-    if (action == GLFW_PRESS)   state->keys[key] = true;
-    if (action == GLFW_RELEASE) state->keys[key] = false;
+    if (action == GLFW_REPEAT) return;  // held state already covers it
+
+    InputEvent e;
+    e.time    = InputEvent::Clock::now();
+    e.type    = InputEvent::Type::Key;
+    e.key     = static_cast<std::int16_t>(key);
+    e.pressed = action == GLFW_PRESS;
+    pushEvent(*source, e);
 }
 
 static void cursorCallback(GLFWwindow* window, double xpos, double ypos)
 {
-    auto* state = static_cast<InputState*>(glfwGetWindowUserPointer(window));
-    if (!state) return;
+    auto* source = static_cast<InputSource*>(glfwGetWindowUserPointer(window));
+    if (!source) return;
 
-    if (state->firstCursor) {
-        state->lastCursorX = xpos;
-        state->lastCursorY = ypos;
-        state->firstCursor = false;
+    if (source->firstCursor) {
+        source->lastCursorX = xpos;
+        source->lastCursorY = ypos;
+        source->firstCursor = false;
     }
 
-    state->mouseDeltaX += static_cast<float>(xpos - state->lastCursorX);
-    state->mouseDeltaY += static_cast<float>(state->lastCursorY - ypos); // Y inverted
-    state->lastCursorX  = xpos;
-    state->lastCursorY  = ypos;
+    InputEvent e;
+    e.time = InputEvent::Clock::now();
+    e.type = InputEvent::Type::Cursor;
+    e.dx   = static_cast<float>(xpos - source->lastCursorX);
+    e.dy   = static_cast<float>(source->lastCursorY - ypos); // Y inverted
+    source->lastCursorX = xpos;
+    source->lastCursorY = ypos;
+    pushEvent(*source, e);
 }
 
-void inputAttach(GLFWwindow* window, InputState& state)
+void inputAttach(GLFWwindow* window, InputSource& source)
 {
-    glfwSetWindowUserPointer(window, &state);
+    glfwSetWindowUserPointer(window, &source);
     glfwSetKeyCallback(window, keyCallback);
     glfwSetCursorPosCallback(window, cursorCallback);
     glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
@@ -36,14 +54,8 @@ void inputAttach(GLFWwindow* window, InputState& state)
         glfwSetInputMode(window, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
 }
 
-void inputBeginFrame(InputState& state)
-{
-    state.mouseDeltaX = 0.0f;
-    state.mouseDeltaY = 0.0f;
-}
-
-bool inputKey(const InputState& state, int key)
+void inputAddQueue(InputSource& source, InputQueue& queue)
 {
-    if (key < 0 || key > GLFW_KEY_LAST) return false;
-    return state.keys[key];
+    if (source.queueCount < InputSource::kMaxQueues)
+        source.queues[source.queueCount++] = &queue;
 }
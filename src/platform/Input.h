@@ -1,16 +1,22 @@
 #pragma once
 
 #include <GLFW/glfw3.h>
+#include <cstdint>
+#include "core/InputQueue.h"
 
-struct InputState {
-    bool   keys[GLFW_KEY_LAST + 1]{};
-    float  mouseDeltaX{0.0f};
-    float  mouseDeltaY{0.0f};
-    double lastCursorX{0.0};
-    double lastCursorY{0.0};
-    bool   firstCursor{true};
+// Window-thread side of input. GLFW callbacks timestamp every key and
+// cursor event and push it to each attached queue; the render loop and the
+// simulation replay their own queue into an InputState.
+struct InputSource {
+    static constexpr int kMaxQueues = 4;
+
+    InputQueue*   queues[kMaxQueues]{};
+    int           queueCount{0};
+    double        lastCursorX{0.0};
+    double        lastCursorY{0.0};
+    bool          firstCursor{true};
+    std::uint64_t dropped{0};  // events that found a queue full
 };
 
-void inputAttach(GLFWwindow* window, InputState& state);
-void inputBeginFrame(InputState& state);
-bool inputKey(const InputState& state, int key);
+void inputAttach(GLFWwindow* window, InputSource& source);
+void inputAddQueue(InputSource& source, InputQueue& queue);  // before events start
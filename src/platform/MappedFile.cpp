@@ -0,0 +1,103 @@
+#include "MappedFile.h"
+
+#include <cstdio>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPEDFILE_MMAP 1
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+#if defined(MAPPEDFILE_MMAP)
+
+bool MappedFile::open(const char* path)
+{
+    close();
+
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        std::fprintf(stderr, "Failed to open %s\n", path);
+        return false;
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        std::fprintf(stderr, "Failed to stat %s (or it is empty)\n", path);
+        ::close(fd);
+        return false;
+    }
+
+    void* p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // the mapping keeps the file alive
+    if (p == MAP_FAILED) {
+        std::fprintf(stderr, "Failed to map %s\n", path);
+        return false;
+    }
+
+    m_data   = p;
+    m_size   = static_cast<std::size_t>(st.st_size);
+    m_mapped = true;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (m_mapped) ::munmap(const_cast<void*>(m_data), m_size);
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+    m_data   = nullptr;
+    m_size   = 0;
+    m_mapped = false;
+}
+
+#else
+
+bool MappedFile::open(const char* path)
+{
+    close();
+
+    std::FILE* f = std::fopen(path, "rb");
+    if (!f) {
+        std::fprintf(stderr, "Failed to open %s\n", path);
+        return false;
+    }
+
+    std::fseek(f, 0, SEEK_END);
+    long size = std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+    if (size <= 0) {
+        std::fprintf(stderr, "Failed to size %s (or it is empty)\n", path);
+        std::fclose(f);
+        return false;
+    }
+
+    m_buffer.resize(static_cast<std::size_t>(size));
+    bool ok = std::fread(m_buffer.data(), 1, m_buffer.size(), f) == m_buffer.size();
+    std::fclose(f);
+    if (!ok) {
+        std::fprintf(stderr, "Failed to read %s\n", path);
+        m_buffer.clear();
+        return false;
+    }
+
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+    return true;
+}
+
+void MappedFile::close()
+{
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#endif
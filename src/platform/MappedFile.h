@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Read-only view of a whole file.
+// POSIX: mmap, pages fault in on first touch. Elsewhere: one fread into an
+// owned buffer — same interface, no OS headers leak out of this file.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const char* path);
+    void close();
+
+    const void* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+
+private:
+    const void*                m_data{nullptr};
+    std::size_t                m_size{0};
+    bool                       m_mapped{false};
+    std::vector<unsigned char> m_buffer;  // fallback storage
+};
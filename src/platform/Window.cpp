@@ -56,3 +56,33 @@ void Window::pollEvents()
 {
     glfwPollEvents();
 }
+
+std::unique_ptr<SharedContext> Window::createSharedContext()
+{
+    // Same version hints as the main window; they persist from the constructor
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* hidden = glfwCreateWindow(1, 1, "", nullptr, m_window);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+    if (!hidden) {
+        std::fprintf(stderr, "Failed to create shared GL context\n");
+        std::exit(1);
+    }
+    return std::unique_ptr<SharedContext>(new SharedContext(hidden));
+}
+
+// ---------- shared context ----------
+
+SharedContext::~SharedContext()
+{
+    glfwDestroyWindow(m_window);
+}
+
+void SharedContext::makeCurrent()
+{
+    glfwMakeContextCurrent(m_window);
+}
+
+void SharedContext::release()
+{
+    glfwMakeContextCurrent(nullptr);
+}
@@ -1,6 +1,27 @@
 #pragma once
 
 #include <GLFW/glfw3.h>
+#include <memory>
+
+// Hidden window whose GL context shares objects with the Window that made
+// it: buffers, textures, programs and sync objects, but not VAOs. Current
+// on at most one thread at a time; destroy it on the main thread.
+class SharedContext {
+public:
+    ~SharedContext();
+
+    SharedContext(const SharedContext&)            = delete;
+    SharedContext& operator=(const SharedContext&) = delete;
+
+    void makeCurrent();  // on the thread that will use it
+    void release();      // before that thread exits
+
+private:
+    friend class Window;
+    explicit SharedContext(GLFWwindow* window) : m_window(window) {}
+
+    GLFWwindow* m_window{nullptr};
+};
 
 class Window {
 public:
@@ -13,6 +34,10 @@ public:
     bool       shouldClose() const;
     void       swapBuffers();
     void       pollEvents();
+
+    // Main thread only (GLFW creates windows there); exits on failure
+    std::unique_ptr<SharedContext> createSharedContext();
+
     GLFWwindow* handle() const { return m_window; }
     int        width()   const { return m_width; }
     int        height()  const { return m_height; }
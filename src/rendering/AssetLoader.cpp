@@ -0,0 +1,161 @@
+#include "AssetLoader.h"
+#include "core/Profiler.h"
+#include "platform/MappedFile.h"
+#include "platform/Window.h"
+
+#include <algorithm>
+#include <cstdio>
+
+AssetLoader::AssetLoader(std::unique_ptr<SharedContext> context, GeometryArena& arena,
+                         unsigned workerThreads)
+    : m_context(std::move(context)), m_arena(arena)
+{
+    for (unsigned i = 0; i < std::max(workerThreads, 1u); ++i)
+        m_workers.emplace_back([this] { workerLoop(); });
+    m_uploader = std::thread([this] { uploadLoop(); });
+}
+
+AssetLoader::~AssetLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_jobReady.notify_all();
+    m_decodedReady.notify_all();
+    for (std::thread& t : m_workers) t.join();
+    m_uploader.join();
+
+    // Fences are shared objects: delete the ones nobody polled
+    for (const Uploaded& u : m_fenced)
+        if (u.fence) glDeleteSync(u.fence);
+    for (const Uploaded& u : m_uploaded)
+        if (u.fence) glDeleteSync(u.fence);
+}
+
+// ---------- requests (main thread) ----------
+
+AssetId AssetLoader::enqueue(Job job)
+{
+    const auto id = static_cast<AssetId>(m_assets.size());
+    job.id = id;
+    m_assets.emplace_back();
+    ++m_pending;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_jobReady.notify_one();
+    return id;
+}
+
+AssetId AssetLoader::loadMesh(std::function<MeshGeometry()> generate)
+{
+    return enqueue({0, std::move(generate), {}});
+}
+
+AssetId AssetLoader::loadMeshFile(std::string path)
+{
+    return enqueue({0, nullptr, std::move(path)});
+}
+
+void AssetLoader::poll()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fenced.insert(m_fenced.end(), m_uploaded.begin(), m_uploaded.end());
+        m_uploaded.clear();
+    }
+
+    bool arrived = false;
+    auto done = [&](const Uploaded& u) {
+        Asset& a = m_assets[u.id];
+        if (!u.ok) {
+            a.state = State::Failed;
+        } else {
+            // Zero timeout: just asks whether the GPU got there
+            const GLenum r = glClientWaitSync(u.fence, 0, 0);
+            if (r != GL_ALREADY_SIGNALED && r != GL_CONDITION_SATISFIED) return false;
+            glDeleteSync(u.fence);
+            a.state = State::Ready;
+            a.mesh  = u.mesh;
+            arrived = true;
+        }
+        --m_pending;
+        return true;
+    };
+    m_fenced.erase(std::remove_if(m_fenced.begin(), m_fenced.end(), done), m_fenced.end());
+
+    if (arrived) m_arena.reattach();
+}
+
+// ---------- loader threads ----------
+
+void AssetLoader::workerLoop()
+{
+    profilerSetThreadName("asset worker");
+
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobReady.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+            if (m_stop) return;
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        Decoded d;
+        d.id = job.id;
+        if (job.generate) {
+            PROFILE_SCOPE("generate mesh");
+            d.geometry = job.generate();
+        } else {
+            PROFILE_SCOPE("read mesh file");
+            d.file = std::make_unique<MappedFile>();
+            d.ok   = d.file->open(job.path.c_str()) &&
+                     openMeshFile(d.file->data(), d.file->size(), d.view);
+            if (!d.ok) std::fprintf(stderr, "AssetLoader: cannot load %s\n", job.path.c_str());
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_decoded.push_back(std::move(d));
+        }
+        m_decodedReady.notify_one();
+    }
+}
+
+void AssetLoader::uploadLoop()
+{
+    profilerSetThreadName("asset upload");
+    m_context->makeCurrent();
+
+    for (;;) {
+        Decoded d;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_decodedReady.wait(lock, [this] { return m_stop || !m_decoded.empty(); });
+            if (m_stop) break;
+            d = std::move(m_decoded.front());
+            m_decoded.pop_front();
+        }
+
+        Uploaded u;
+        u.id = d.id;
+        u.ok = d.ok;
+        if (d.ok) {
+            PROFILE_SCOPE("upload mesh");
+            u.ok = d.file ? m_arena.add(d.view, u.mesh) : m_arena.add(d.geometry, u.mesh);
+        }
+        if (u.ok) {
+            u.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();  // another context only sees the fence signal once it's submitted
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_uploaded.push_back(u);
+    }
+
+    m_context->release();
+}
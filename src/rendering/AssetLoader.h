@@ -0,0 +1,104 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "GeometryArena.h"
+#include "MeshFormat.h"
+
+class MappedFile;
+class SharedContext;
+
+using AssetId = std::uint32_t;
+
+// Loads meshes into a GeometryArena without holding up the render loop.
+//
+//   workers:  run generators, map and validate mesh files
+//   uploader: GeometryArena::add() on a shared context, then a fence
+//   main:     poll() once per frame; a mesh is ready() once its fence has
+//             signalled, and stays valid as long as the arena. One that
+//             can't be read or doesn't fit in the arena is failed().
+//
+// While the loader lives it is the only caller of the arena's add().
+class AssetLoader {
+public:
+    AssetLoader(std::unique_ptr<SharedContext> context, GeometryArena& arena,
+                unsigned workerThreads = 2);
+    ~AssetLoader();  // drops queued work, finishes jobs already running
+
+    AssetLoader(const AssetLoader&)            = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // generate() runs on a worker thread
+    AssetId loadMesh(std::function<MeshGeometry()> generate);
+    AssetId loadMeshFile(std::string path);  // writeMeshFile() format
+
+    // Main thread: publishes uploads whose fences have signalled
+    void poll();
+
+    bool             ready(AssetId id) const { return m_assets[id].state == State::Ready; }
+    bool             failed(AssetId id) const { return m_assets[id].state == State::Failed; }
+    const ArenaMesh& mesh(AssetId id) const { return m_assets[id].mesh; }  // once ready()
+    std::size_t      pending() const { return m_pending; }
+
+private:
+    enum class State : std::uint8_t { Pending, Ready, Failed };
+
+    struct Asset {
+        State     state{State::Pending};
+        ArenaMesh mesh;
+    };
+
+    struct Job {
+        AssetId                        id{0};
+        std::function<MeshGeometry()>  generate;  // or
+        std::string                    path;
+    };
+
+    struct Decoded {
+        AssetId                     id{0};
+        bool                        ok{true};
+        MeshGeometry                geometry;
+        std::unique_ptr<MappedFile> file;  // uploaded straight from the mapping
+        MeshView                    view;
+    };
+
+    struct Uploaded {
+        AssetId   id{0};
+        bool      ok{true};
+        ArenaMesh mesh;
+        GLsync    fence{nullptr};
+    };
+
+    AssetId enqueue(Job job);
+    void    workerLoop();
+    void    uploadLoop();
+
+    std::unique_ptr<SharedContext> m_context;
+    GeometryArena&                 m_arena;
+
+    // Between threads, under m_mutex
+    std::mutex              m_mutex;
+    std::condition_variable m_jobReady;
+    std::condition_variable m_decodedReady;
+    std::deque<Job>         m_jobs;
+    std::deque<Decoded>     m_decoded;
+    std::vector<Uploaded>   m_uploaded;
+    bool                    m_stop{false};
+
+    std::vector<std::thread> m_workers;
+    std::thread              m_uploader;
+
+    // Main thread only
+    std::vector<Asset>    m_assets;
+    std::vector<Uploaded> m_fenced;  // uploaded, GPU not done yet
+    std::size_t           m_pending{0};
+};
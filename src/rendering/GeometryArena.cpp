@@ -0,0 +1,190 @@
+#include "GeometryArena.h"
+
+#include <cstdio>
+#include <cstring>
+
+// ---------- arena ----------
+
+static int regionOf(GLenum indexType)
+{
+    return indexType == GL_UNSIGNED_INT ? 1 : 0;
+}
+
+static std::size_t indexSize(GLenum indexType)
+{
+    return indexType == GL_UNSIGNED_INT ? 4 : 2;
+}
+
+GeometryArena::GeometryArena(std::size_t maxVertices, std::size_t maxIndices,
+                             std::size_t maxWideIndices)
+    : m_maxVertices(maxVertices)
+{
+    glCreateBuffers(1, &m_vbo);
+    glNamedBufferStorage(m_vbo, static_cast<GLsizeiptr>(maxVertices * sizeof(PackedVertex)),
+                         nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+    m_regions[0].maxIndices = maxIndices;
+    m_regions[1].maxIndices = maxWideIndices;
+    for (int r = 0; r < 2; ++r) {
+        IndexRegion& region = m_regions[r];
+        if (region.maxIndices == 0) continue;
+
+        glCreateBuffers(1, &region.ebo);
+        glNamedBufferStorage(region.ebo,
+                             static_cast<GLsizeiptr>(region.maxIndices * (r == 1 ? 4 : 2)),
+                             nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+        // Same formats as the mesh file: half xyz at loc 0, octahedral
+        // snorm16 normal at loc 1
+        glCreateVertexArrays(1, &region.vao);
+        glVertexArrayVertexBuffer(region.vao, 0, m_vbo, 0, sizeof(PackedVertex));
+        glVertexArrayElementBuffer(region.vao, region.ebo);
+
+        glVertexArrayAttribFormat(region.vao, 0, 3, GL_HALF_FLOAT, GL_FALSE,
+                                  offsetof(PackedVertex, position));
+        glVertexArrayAttribBinding(region.vao, 0, 0);
+        glEnableVertexArrayAttrib(region.vao, 0);
+
+        glVertexArrayAttribFormat(region.vao, 1, 2, GL_SHORT, GL_TRUE,
+                                  offsetof(PackedVertex, normal));
+        glVertexArrayAttribBinding(region.vao, 1, 0);
+        glEnableVertexArrayAttrib(region.vao, 1);
+    }
+}
+
+GeometryArena::~GeometryArena()
+{
+    for (const IndexRegion& region : m_regions) {
+        glDeleteVertexArrays(1, &region.vao);
+        glDeleteBuffers(1, &region.ebo);
+    }
+    glDeleteBuffers(1, &m_vbo);
+}
+
+bool GeometryArena::append(const void* vertices, std::size_t vertexCount,
+                           const void* indices, std::size_t indexCount, GLenum indexType,
+                           ArenaMesh& out)
+{
+    IndexRegion& region = m_regions[regionOf(indexType)];
+    if (m_vertexCount + vertexCount > m_maxVertices ||
+        region.indexCount + indexCount > region.maxIndices) {
+        std::fprintf(stderr, "GeometryArena: out of space (%zu + %zu vertices, %zu + %zu %d-bit indices)\n",
+                     m_vertexCount, vertexCount, region.indexCount, indexCount,
+                     static_cast<int>(indexSize(indexType) * 8));
+        return false;
+    }
+
+    const std::size_t stride = indexSize(indexType);
+    glNamedBufferSubData(m_vbo, static_cast<GLintptr>(m_vertexCount * sizeof(PackedVertex)),
+                         static_cast<GLsizeiptr>(vertexCount * sizeof(PackedVertex)), vertices);
+    glNamedBufferSubData(region.ebo, static_cast<GLintptr>(region.indexCount * stride),
+                         static_cast<GLsizeiptr>(indexCount * stride), indices);
+
+    out.firstIndex = static_cast<GLuint>(region.indexCount);
+    out.indexCount = static_cast<GLuint>(indexCount);
+    out.baseVertex = static_cast<GLint>(m_vertexCount);
+    out.indexType  = indexType;
+
+    m_vertexCount     += vertexCount;
+    region.indexCount += indexCount;
+    return true;
+}
+
+bool GeometryArena::add(const MeshGeometry& g, ArenaMesh& out)
+{
+    if (!g.fits16())
+        return append(g.vertices.data(), g.vertices.size(),
+                      g.indices.data(), g.indices.size(), GL_UNSIGNED_INT, out);
+
+    std::vector<std::uint16_t> narrow(g.indices.begin(), g.indices.end());
+    return append(g.vertices.data(), g.vertices.size(),
+                  narrow.data(), narrow.size(), GL_UNSIGNED_SHORT, out);
+}
+
+bool GeometryArena::add(const MeshView& file, ArenaMesh& out)
+{
+    // Straight from the mapping, in whichever index size the file uses
+    const MeshFileHeader& h = *file.header;
+    return append(file.vertices(), h.vertexCount, file.indices(), h.indexCount,
+                  h.indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, out);
+}
+
+void GeometryArena::bind(GLenum indexType) const
+{
+    glBindVertexArray(m_regions[regionOf(indexType)].vao);
+}
+
+void GeometryArena::reattach() const
+{
+    for (const IndexRegion& region : m_regions) {
+        if (!region.vao) continue;
+        glVertexArrayVertexBuffer(region.vao, 0, m_vbo, 0, sizeof(PackedVertex));
+        glVertexArrayElementBuffer(region.vao, region.ebo);
+    }
+}
+
+// ---------- draw list ----------
+
+void DrawList::clear()
+{
+    for (int r = 0; r < 2; ++r) {
+        m_commands[r].clear();
+        m_data[r].clear();
+    }
+}
+
+void DrawList::add(const ArenaMesh& mesh, GLuint instanceCount, GLuint firstInstance,
+                   const glm::vec3& color)
+{
+    if (instanceCount == 0) return;
+    const int r = regionOf(mesh.indexType);
+    m_commands[r].push_back({mesh.indexCount, instanceCount, mesh.firstIndex, mesh.baseVertex,
+                             firstInstance});
+    m_data[r].push_back({glm::vec4(color, 1.0f)});
+}
+
+void DrawList::submit(const GeometryArena& arena, GLuint dataBinding)
+{
+    if (size() == 0) return;
+
+    // Region layout: [commands 16][commands 32][pad][data 16][pad][data 32].
+    // gl_DrawID restarts at 0 for each multi-draw, so each batch binds its
+    // own slice of per-draw data.
+    const std::size_t align = m_stream.alignment();
+    auto alignUp = [align](std::size_t n) { return (n + align - 1) / align * align; };
+
+    std::size_t cmdAt[2], dataAt[2];
+    std::size_t end = 0;
+    for (int r = 0; r < 2; ++r) {
+        cmdAt[r] = end;
+        end     += m_commands[r].size() * sizeof(DrawElementsIndirectCommand);
+    }
+    for (int r = 0; r < 2; ++r) {
+        dataAt[r] = alignUp(end);
+        end       = dataAt[r] + m_data[r].size() * sizeof(DrawData);
+    }
+
+    auto* dst = static_cast<unsigned char*>(m_stream.map(end));
+    for (int r = 0; r < 2; ++r) {
+        std::memcpy(dst + cmdAt[r], m_commands[r].data(),
+                    m_commands[r].size() * sizeof(DrawElementsIndirectCommand));
+        std::memcpy(dst + dataAt[r], m_data[r].data(), m_data[r].size() * sizeof(DrawData));
+    }
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_stream.buffer());
+    const GLenum types[2] = {GL_UNSIGNED_SHORT, GL_UNSIGNED_INT};
+    for (int r = 0; r < 2; ++r) {
+        if (m_commands[r].empty()) continue;
+        arena.bind(types[r]);
+        m_stream.bindRange(GL_SHADER_STORAGE_BUFFER, dataBinding, dataAt[r],
+                           m_data[r].size() * sizeof(DrawData));
+        glMultiDrawElementsIndirect(GL_TRIANGLES, types[r],
+                                    reinterpret_cast<const void*>(m_stream.regionOffset() + cmdAt[r]),
+                                    static_cast<GLsizei>(m_commands[r].size()), 0);
+    }
+}
+
+void DrawList::endFrame()
+{
+    m_stream.endFrame();
+}
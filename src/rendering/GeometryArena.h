@@ -0,0 +1,101 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "MeshFormat.h"
+#include "StreamBuffer.h"
+
+// Where a mesh lives inside the arena; the fields a draw command needs
+struct ArenaMesh {
+    GLuint  firstIndex{0};  // in indexType units
+    GLuint  indexCount{0};
+    GLint   baseVertex{0};
+    GLenum  indexType{GL_UNSIGNED_SHORT};
+};
+
+// Every mesh in one vertex buffer (PackedVertex layout) plus two index
+// buffers: 16-bit for meshes of ≤ 65536 vertices, 32-bit for the rest and
+// for files stored with 32-bit indices. Indices stay mesh-relative and
+// draws add baseVertex. Each index buffer has its own VAO, since the
+// element buffer is VAO state. Capacity is fixed up front; add() fails
+// (with a message) on a mesh that no longer fits.
+// add() may run on another thread with a shared context (AssetLoader), one
+// thread at a time; bind() and draws stay on the thread that made the arena.
+class GeometryArena {
+public:
+    GeometryArena(std::size_t maxVertices, std::size_t maxIndices, std::size_t maxWideIndices = 0);
+    ~GeometryArena();
+
+    GeometryArena(const GeometryArena&)            = delete;
+    GeometryArena& operator=(const GeometryArena&) = delete;
+
+    bool add(const MeshGeometry& geometry, ArenaMesh& out);
+    bool add(const MeshView& file, ArenaMesh& out);  // uploads straight from the mapping
+
+    void bind(GLenum indexType) const;  // the VAO for that index buffer
+
+    // Re-attaches the buffers to the VAO: a context only sees another
+    // context's writes (once fenced) after binding the objects again
+    void reattach() const;
+
+private:
+    // 16-bit and 32-bit halves: [0] = GL_UNSIGNED_SHORT, [1] = GL_UNSIGNED_INT
+    struct IndexRegion {
+        GLuint      vao{0};
+        GLuint      ebo{0};
+        std::size_t maxIndices{0};
+        std::size_t indexCount{0};
+    };
+
+    bool append(const void* vertices, std::size_t vertexCount,
+                const void* indices, std::size_t indexCount, GLenum indexType, ArenaMesh& out);
+
+    GLuint      m_vbo{0};
+    std::size_t m_maxVertices{0};
+    std::size_t m_vertexCount{0};
+    IndexRegion m_regions[2];
+};
+
+// glMultiDrawElementsIndirect command, as the GL reads it
+struct DrawElementsIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint  baseVertex;
+    GLuint baseInstance;  // first InstanceData slot; object.vert adds gl_InstanceID
+};
+static_assert(sizeof(DrawElementsIndirectCommand) == 20, "indirect command layout");
+
+// Per-draw data (std430), indexed by gl_DrawID in object.vert
+constexpr GLuint kDrawDataBinding = 1;  // SSBO; 0 is InstanceBuffer
+
+struct DrawData {
+    glm::vec4 color;  // rgb; a unused
+};
+
+// One frame's draws for one program, submitted as one
+// glMultiDrawElementsIndirect per index type in use (usually just the
+// 16-bit one). Commands and per-draw data are streamed through a
+// persistently mapped ring, so recording never stalls the GPU.
+class DrawList {
+public:
+    void clear();
+    void add(const ArenaMesh& mesh, GLuint instanceCount, GLuint firstInstance,
+             const glm::vec3& color);
+
+    // Binds the arena's VAOs and each batch's per-draw data to the SSBO
+    // `dataBinding`
+    void submit(const GeometryArena& arena, GLuint dataBinding);
+    void endFrame();
+
+    std::size_t size() const { return m_commands[0].size() + m_commands[1].size(); }
+
+private:
+    // Per index type, as GeometryArena's regions
+    std::vector<DrawElementsIndirectCommand> m_commands[2];
+    std::vector<DrawData>                    m_data[2];
+    StreamBuffer                             m_stream;
+};
@@ -0,0 +1,64 @@
+#include "GpuProfiler.h"
+
+GpuProfiler::GpuProfiler()
+{
+#if defined(PROFILER_ENABLED)
+    glCreateQueries(GL_TIMESTAMP, kFrames * kMaxPasses * 2, &m_queries[0][0][0]);
+    m_track = profilerCreateTrack("GPU");
+
+    GLint64 gpuNow = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+    m_offsetNs = static_cast<std::int64_t>(profilerNow()) - gpuNow;
+#endif
+}
+
+GpuProfiler::~GpuProfiler()
+{
+#if defined(PROFILER_ENABLED)
+    glDeleteQueries(kFrames * kMaxPasses * 2, &m_queries[0][0][0]);
+#endif
+}
+
+int GpuProfiler::begin(const char* name)
+{
+    if (!profilerEnabled()) return -1;
+
+    const int pass = m_passCount[m_frame];
+    if (pass == kMaxPasses) return -1;
+
+    m_names[m_frame][pass] = name;
+    m_passCount[m_frame]   = pass + 1;
+    glQueryCounter(m_queries[m_frame][pass][0], GL_TIMESTAMP);
+    return pass;
+}
+
+void GpuProfiler::end(int pass)
+{
+    if (pass < 0) return;
+    glQueryCounter(m_queries[m_frame][pass][1], GL_TIMESTAMP);
+}
+
+void GpuProfiler::endFrame()
+{
+    m_frame = (m_frame + 1) % kFrames;
+
+    // The slot being reused holds the frame from kFrames ago
+    const int n = m_passCount[m_frame];
+    if (n > 0) {
+        GLint ready = 0;
+        glGetQueryObjectiv(m_queries[m_frame][n - 1][1], GL_QUERY_RESULT_AVAILABLE, &ready);
+        if (ready) {
+            for (int p = 0; p < n; ++p) {
+                GLuint64 t0 = 0, t1 = 0;
+                glGetQueryObjectui64v(m_queries[m_frame][p][0], GL_QUERY_RESULT, &t0);
+                glGetQueryObjectui64v(m_queries[m_frame][p][1], GL_QUERY_RESULT, &t1);
+                profilerRecordOn(m_track, m_names[m_frame][p],
+                                 static_cast<std::uint64_t>(static_cast<std::int64_t>(t0) + m_offsetNs),
+                                 static_cast<std::uint64_t>(static_cast<std::int64_t>(t1) + m_offsetNs));
+            }
+        } else {
+            ++m_dropped;
+        }
+    }
+    m_passCount[m_frame] = 0;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <cstdint>
+#include "core/Profiler.h"
+
+// GPU pass timing on the profiler's "GPU" track.
+// Each pass brackets its commands with two glQueryCounter(GL_TIMESTAMP)
+// queries; results are read kFrames frames later, when the GPU is long done
+// with them, so collection never stalls (a late frame is dropped instead).
+// GPU timestamps are mapped onto profilerNow() with an offset taken at
+// construction. Everything here is a no-op while the profiler is disabled.
+class GpuProfiler {
+public:
+    static constexpr int kFrames    = 4;
+    static constexpr int kMaxPasses = 16;
+
+    GpuProfiler();
+    ~GpuProfiler();
+
+    GpuProfiler(const GpuProfiler&)            = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    // Returns the pass index for end(), or -1 when not recording
+    int  begin(const char* name);
+    void end(int pass);
+
+    // After the frame's last pass: publish the oldest frame, start the next
+    void endFrame();
+
+    std::uint64_t droppedFrames() const { return m_dropped; }
+
+private:
+    GLuint        m_queries[kFrames][kMaxPasses][2]{};
+    const char*   m_names[kFrames][kMaxPasses]{};
+    int           m_passCount[kFrames]{};
+    int           m_frame{0};
+    std::int64_t  m_offsetNs{0};  // profilerNow() - GL_TIMESTAMP
+    std::uint32_t m_track{0};
+    std::uint64_t m_dropped{0};
+};
+
+class GpuProfileScope {
+public:
+    GpuProfileScope(GpuProfiler& gpu, const char* name) : m_gpu(gpu), m_pass(gpu.begin(name)) {}
+    ~GpuProfileScope() { m_gpu.end(m_pass); }
+
+    GpuProfileScope(const GpuProfileScope&)            = delete;
+    GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+private:
+    GpuProfiler& m_gpu;
+    int          m_pass;
+};
+
+#if defined(PROFILER_ENABLED)
+#define GPU_PROFILE_SCOPE(gpu, name) \
+    GpuProfileScope PROFILE_CONCAT(gpuProfileScope_, __LINE__)(gpu, name)
+#else
+#define GPU_PROFILE_SCOPE(gpu, name) ((void)0)
+#endif
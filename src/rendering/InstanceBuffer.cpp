@@ -0,0 +1,17 @@
+#include "InstanceBuffer.h"
+
+InstanceData* InstanceBuffer::map(std::size_t count)
+{
+    m_count = count;
+    return static_cast<InstanceData*>(m_stream.map(count * sizeof(InstanceData)));
+}
+
+void InstanceBuffer::bind(GLuint binding) const
+{
+    m_stream.bindRange(GL_SHADER_STORAGE_BUFFER, binding, 0, m_count * sizeof(InstanceData));
+}
+
+void InstanceBuffer::endFrame()
+{
+    m_stream.endFrame();
+}
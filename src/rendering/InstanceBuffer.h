@@ -0,0 +1,36 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <cstddef>
+#include <cstdint>
+#include "StreamBuffer.h"
+
+// Per-instance transform as object.vert reads it (std430, 32 bytes):
+// world = position + rotate(rotation, scale * vertex)
+struct InstanceData {
+    float px, py, pz;
+    float scale;
+    float qx, qy, qz, qw;  // unit quaternion
+};
+static_assert(sizeof(InstanceData) == 32, "must match the std430 Instance struct");
+
+// Shader storage ring of InstanceData, written in place every frame.
+// Frame N's transforms go straight into mapped memory while the GPU still
+// draws N-1 and N-2; no copies, no orphaning, no implicit sync.
+class InstanceBuffer {
+public:
+    // `count` slots for this frame; valid until endFrame()
+    InstanceData* map(std::size_t count);
+
+    // Bind this frame's slots as the SSBO at `binding`
+    void bind(GLuint binding) const;
+
+    // Call after the last draw that reads this frame's slots
+    void endFrame();
+
+    std::uint64_t stalls() const { return m_stream.stalls(); }
+
+private:
+    StreamBuffer m_stream;
+    std::size_t  m_count{0};
+};
@@ -1,66 +1,15 @@
 #include "Mesh.h"
 
+#include <algorithm>
+#include <unordered_map>
 #include <vector>
 #include <cmath>
-
-// ---------- helpers ----------
-
-static Mesh uploadMesh(const std::vector<float>& verts, const std::vector<unsigned>& indices)
-{
-    Mesh m;
-    m.indexCount = static_cast<GLsizei>(indices.size());
-
-    glGenVertexArrays(1, &m.vao);
-    glGenBuffers(1, &m.vbo);
-    glGenBuffers(1, &m.ebo);
-
-    glBindVertexArray(m.vao);
-
-    glBindBuffer(GL_ARRAY_BUFFER, m.vbo);
-    glBufferData(GL_ARRAY_BUFFER,
-                 static_cast<GLsizeiptr>(verts.size() * sizeof(float)),
-                 verts.data(), GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m.ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                 static_cast<GLsizeiptr>(indices.size() * sizeof(unsigned)),
-                 indices.data(), GL_STATIC_DRAW);
-
-    // position (loc 0) — stride = 6 floats (pos + normal)
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float),
-                          reinterpret_cast<void*>(0));
-    glEnableVertexAttribArray(0);
-
-    // normal (loc 1)
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float),
-                          reinterpret_cast<void*>(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    glBindVertexArray(0);
-    return m;
-}
-
-// ---------- public API ----------
-
-void Mesh::draw() const
-{
-    glBindVertexArray(vao);
-    glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr);
-    glBindVertexArray(0);
-}
-
-void Mesh::destroy()
-{
-    glDeleteVertexArrays(1, &vao);
-    glDeleteBuffers(1, &vbo);
-    glDeleteBuffers(1, &ebo);
-    vao = vbo = ebo = 0;
-    indexCount = 0;
-}
+#include <cstddef>
+#include <cstdint>
 
 // ---------- cube ----------
 
-Mesh Mesh::buildCube()
+MeshGeometry Mesh::cubeGeometry()
 {
     // 24 vertices: 4 per face, 6 faces.  Layout: px py pz nx ny nz
     // clang-format off
@@ -98,54 +47,65 @@ Mesh Mesh::buildCube()
     };
     // clang-format on
 
-    std::vector<unsigned> idx;
-    idx.reserve(36);
-    for (unsigned f = 0; f < 6; ++f) {
-        unsigned b = f * 4;
-        idx.insert(idx.end(), {b,b+1,b+2, b,b+2,b+3});
+    MeshGeometry g;
+    for (std::size_t i = 0; i < v.size(); i += 6)
+        g.vertices.push_back(packVertex({v[i], v[i + 1], v[i + 2]}, {v[i + 3], v[i + 4], v[i + 5]}));
+
+    g.indices.reserve(36);
+    for (std::uint32_t f = 0; f < 6; ++f) {
+        std::uint32_t b = f * 4;
+        g.indices.insert(g.indices.end(), {b,b+1,b+2, b,b+2,b+3});
     }
 
-    return uploadMesh(v, idx);
+    return g;
 }
 
-// ---------- sphere ----------
+// ---------- icosphere ----------
 
-Mesh Mesh::buildSphere(int rings, int sectors)
+MeshGeometry Mesh::icosphereGeometry(int subdivisions)
 {
-    constexpr float PI = 3.14159265358979f;
-    const float R = 0.5f;
-
-    std::vector<float>    verts;
-    std::vector<unsigned> indices;
+    // Icosahedron: three orthogonal golden rectangles
+    const float t = (1.0f + std::sqrt(5.0f)) * 0.5f;
+    std::vector<glm::vec3> p = {
+        {-1,  t,  0}, { 1,  t,  0}, {-1, -t,  0}, { 1, -t,  0},
+        { 0, -1,  t}, { 0,  1,  t}, { 0, -1, -t}, { 0,  1, -t},
+        { t,  0, -1}, { t,  0,  1}, {-t,  0, -1}, {-t,  0,  1},
+    };
+    for (glm::vec3& v : p) v = glm::normalize(v);
 
-    for (int r = 0; r <= rings; ++r) {
-        float phi = PI * r / rings; // 0..PI
-        for (int s = 0; s <= sectors; ++s) {
-            float theta = 2.0f * PI * s / sectors; // 0..2PI
-            float x = std::cos(theta) * std::sin(phi);
-            float y = std::cos(phi);
-            float z = std::sin(theta) * std::sin(phi);
-            // position
-            verts.push_back(x * R);
-            verts.push_back(y * R);
-            verts.push_back(z * R);
-            // normal (unit sphere → normal == position / R)
-            verts.push_back(x);
-            verts.push_back(y);
-            verts.push_back(z);
-        }
-    }
+    // clang-format off
+    std::vector<std::uint32_t> tris = {
+        0,11,5,  0,5,1,   0,1,7,   0,7,10,  0,10,11,
+        1,5,9,   5,11,4,  11,10,2, 10,7,6,  7,1,8,
+        3,9,4,   3,4,2,   3,2,6,   3,6,8,   3,8,9,
+        4,9,5,   2,4,11,  6,2,10,  8,6,7,   9,8,1,
+    };
+    // clang-format on
 
-    int stride = sectors + 1;
-    for (int r = 0; r < rings; ++r) {
-        for (int s = 0; s < sectors; ++s) {
-            unsigned tl = static_cast<unsigned>(r       * stride + s);
-            unsigned tr = static_cast<unsigned>(r       * stride + s + 1);
-            unsigned bl = static_cast<unsigned>((r + 1) * stride + s);
-            unsigned br = static_cast<unsigned>((r + 1) * stride + s + 1);
-            indices.insert(indices.end(), {tl, bl, tr,  tr, bl, br});
+    // Each edge is split once; both triangles sharing it reuse the midpoint
+    for (int s = 0; s < subdivisions; ++s) {
+        std::unordered_map<std::uint64_t, std::uint32_t> midpoints;
+        auto midpoint = [&](std::uint32_t a, std::uint32_t b) {
+            const std::uint64_t key = (std::uint64_t{std::min(a, b)} << 32) | std::max(a, b);
+            auto [it, added] = midpoints.try_emplace(key, static_cast<std::uint32_t>(p.size()));
+            if (added) p.push_back(glm::normalize(p[a] + p[b]));
+            return it->second;
+        };
+
+        std::vector<std::uint32_t> finer;
+        finer.reserve(tris.size() * 4);
+        for (std::size_t i = 0; i < tris.size(); i += 3) {
+            const std::uint32_t a = tris[i], b = tris[i + 1], c = tris[i + 2];
+            const std::uint32_t ab = midpoint(a, b), bc = midpoint(b, c), ca = midpoint(c, a);
+            finer.insert(finer.end(), {a, ab, ca,  b, bc, ab,  c, ca, bc,  ab, bc, ca});
         }
+        tris.swap(finer);
     }
 
-    return uploadMesh(verts, indices);
+    MeshGeometry g;
+    g.vertices.reserve(p.size());
+    for (const glm::vec3& n : p)
+        g.vertices.push_back(packVertex(n * kSphereRadius, n));
+    g.indices = std::move(tris);
+    return g;
 }
@@ -1,16 +1,14 @@
 #pragma once
 
-#include <glad/gl.h>
+#include "MeshFormat.h"
 
+// Procedural meshes, as CPU-side geometry for GeometryArena::add()
 struct Mesh {
-    GLuint   vao{0};
-    GLuint   vbo{0};
-    GLuint   ebo{0};
-    GLsizei  indexCount{0};
+    static constexpr float kSphereRadius = 0.5f;  // sphere model-space radius
 
-    void draw()    const;
-    void destroy();
+    static MeshGeometry cubeGeometry();
 
-    static Mesh buildCube();
-    static Mesh buildSphere(int rings = 16, int sectors = 16);
+    // Subdivided icosahedron, radius kSphereRadius: 10·4^s + 2 vertices,
+    // 20·4^s triangles, no seam or pole crowding
+    static MeshGeometry icosphereGeometry(int subdivisions = 3);
 };
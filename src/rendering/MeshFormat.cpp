@@ -0,0 +1,198 @@
+#include "MeshFormat.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+constexpr char kMagic[8] = {'3', 'D', 'M', 'E', 'S', 'H', '\0', '\0'};
+
+std::uint64_t alignUp(std::uint64_t bytes)
+{
+    return (bytes + kMeshFileAlignment - 1) & ~std::uint64_t{kMeshFileAlignment - 1};
+}
+
+std::int16_t toSnorm16(float v)
+{
+    v = std::clamp(v, -1.0f, 1.0f);
+    return static_cast<std::int16_t>(std::lround(v * 32767.0f));
+}
+
+} // namespace
+
+// ---------- encoding ----------
+
+std::uint16_t floatToHalf(float f)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+
+    const std::uint32_t sign = (bits >> 16) & 0x8000u;
+    const std::int32_t  exp  = static_cast<std::int32_t>((bits >> 23) & 0xFF) - 127 + 15;
+    std::uint32_t       mant = bits & 0x7FFFFFu;
+
+    if (exp >= 31)  // overflow, inf, nan → inf (meshes never hold nan)
+        return static_cast<std::uint16_t>(sign | 0x7C00u);
+    if (exp <= 0) {  // subnormal half or zero
+        if (exp < -10) return static_cast<std::uint16_t>(sign);
+        mant |= 0x800000u;
+        const int shift = 14 - exp;
+        std::uint32_t half = mant >> shift;
+        half += (mant >> (shift - 1)) & 1u;  // round half up
+        return static_cast<std::uint16_t>(sign | half);
+    }
+
+    std::uint32_t half = sign | (static_cast<std::uint32_t>(exp) << 10) | (mant >> 13);
+    half += (mant >> 12) & 1u;  // round; a carry correctly bumps the exponent
+    return static_cast<std::uint16_t>(half);
+}
+
+float halfToFloat(std::uint16_t h)
+{
+    const float sign = (h & 0x8000u) ? -1.0f : 1.0f;
+    const int   exp  = (h >> 10) & 0x1F;
+    const float mant = static_cast<float>(h & 0x3FFu) / 1024.0f;
+
+    if (exp == 0)  return sign * std::ldexp(mant, -14);
+    if (exp == 31) return sign * INFINITY;
+    return sign * std::ldexp(1.0f + mant, exp - 15);
+}
+
+PackedVertex packVertex(const glm::vec3& p, const glm::vec3& n)
+{
+    PackedVertex v{};
+    v.position[0] = floatToHalf(p.x);
+    v.position[1] = floatToHalf(p.y);
+    v.position[2] = floatToHalf(p.z);
+    v.position[3] = floatToHalf(1.0f);
+
+    // Octahedral: project onto |x|+|y|+|z| = 1, fold the lower half over
+    const float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+    float ox = n.x / l1;
+    float oy = n.y / l1;
+    if (n.z < 0.0f) {
+        const float fx = (1.0f - std::abs(oy)) * (ox >= 0.0f ? 1.0f : -1.0f);
+        const float fy = (1.0f - std::abs(ox)) * (oy >= 0.0f ? 1.0f : -1.0f);
+        ox = fx;
+        oy = fy;
+    }
+    v.normal[0] = toSnorm16(ox);
+    v.normal[1] = toSnorm16(oy);
+    return v;
+}
+
+// ---------- read ----------
+
+bool openMeshFile(const void* data, std::size_t size, MeshView& out)
+{
+    const auto* h = static_cast<const MeshFileHeader*>(data);
+
+    if (size < sizeof(MeshFileHeader) || std::memcmp(h->magic, kMagic, sizeof(kMagic)) != 0) {
+        std::fprintf(stderr, "MeshFile: not a mesh file\n");
+        return false;
+    }
+    if (h->endianTag != kMeshFileEndianTag) {
+        std::fprintf(stderr, "MeshFile: written with a different byte order\n");
+        return false;
+    }
+    if (h->version != kMeshFileVersion) {
+        std::fprintf(stderr, "MeshFile: version %u, expected %u\n", h->version, kMeshFileVersion);
+        return false;
+    }
+
+    // 32 × 32 bits: these products can't wrap, but offset + bytes could,
+    // so each offset is checked against the size on its own first
+    const std::uint64_t vertexBytes = std::uint64_t{h->vertexCount} * h->vertexStride;
+    const std::uint64_t indexBytes  = std::uint64_t{h->indexCount} * h->indexSize;
+    if (h->vertexOffset > size || vertexBytes > size - h->vertexOffset ||
+        h->indexOffset > size || indexBytes > size - h->indexOffset) {
+        std::fprintf(stderr, "MeshFile: truncated (%zu bytes)\n", size);
+        return false;
+    }
+    if (h->vertexStride != sizeof(PackedVertex) || (h->indexSize != 2 && h->indexSize != 4) ||
+        h->vertexOffset % kMeshFileAlignment != 0 || h->indexOffset % kMeshFileAlignment != 0 ||
+        h->vertexOffset < h->headerSize || h->indexOffset < h->vertexOffset ||
+        h->indexOffset - h->vertexOffset < vertexBytes) {
+        std::fprintf(stderr, "MeshFile: unexpected layout\n");
+        return false;
+    }
+
+    // An out-of-range index would have the GPU read past the vertex block
+    const unsigned char* indices = static_cast<const unsigned char*>(data) + h->indexOffset;
+    for (std::uint32_t i = 0; i < h->indexCount; ++i) {
+        std::uint32_t index;
+        if (h->indexSize == 2) {
+            std::uint16_t narrow;
+            std::memcpy(&narrow, indices + std::size_t{i} * 2, sizeof(narrow));
+            index = narrow;
+        } else {
+            std::memcpy(&index, indices + std::size_t{i} * 4, sizeof(index));
+        }
+        if (index >= h->vertexCount) {
+            std::fprintf(stderr, "MeshFile: index %u at %u is past %u vertices\n",
+                         index, i, h->vertexCount);
+            return false;
+        }
+    }
+
+    out.header = h;
+    out.base   = static_cast<const unsigned char*>(data);
+    return true;
+}
+
+// ---------- write ----------
+
+bool writeMeshFile(const char* path, const MeshGeometry& g)
+{
+    std::FILE* f = std::fopen(path, "wb");
+    if (!f) {
+        std::fprintf(stderr, "MeshFile: cannot open %s for writing\n", path);
+        return false;
+    }
+
+    const bool          small     = g.fits16();
+    const auto          nv        = static_cast<std::uint32_t>(g.vertices.size());
+    const auto          ni        = static_cast<std::uint32_t>(g.indices.size());
+    const std::uint32_t indexSize = small ? 2 : 4;
+
+    // Bound the encoded positions, i.e. exactly what the GPU will see
+    float radius = 0.0f;
+    for (const PackedVertex& v : g.vertices) {
+        const glm::vec3 p{halfToFloat(v.position[0]), halfToFloat(v.position[1]),
+                          halfToFloat(v.position[2])};
+        radius = std::max(radius, glm::length(p));
+    }
+
+    MeshFileHeader h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version      = kMeshFileVersion;
+    h.headerSize   = static_cast<std::uint32_t>(alignUp(sizeof(MeshFileHeader)));
+    h.vertexCount  = nv;
+    h.indexCount   = ni;
+    h.vertexStride = sizeof(PackedVertex);
+    h.indexSize    = indexSize;
+    h.vertexOffset = h.headerSize;
+    h.indexOffset  = alignUp(h.vertexOffset + std::uint64_t{nv} * sizeof(PackedVertex));
+    h.endianTag    = kMeshFileEndianTag;
+    h.boundsRadius = radius;
+
+    static const unsigned char zeros[kMeshFileAlignment] = {};
+    const std::size_t padding = static_cast<std::size_t>(
+        h.indexOffset - h.vertexOffset - std::uint64_t{nv} * sizeof(PackedVertex));
+
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+    ok = ok && std::fwrite(g.vertices.data(), sizeof(PackedVertex), nv, f) == nv;
+    ok = ok && std::fwrite(zeros, 1, padding, f) == padding;
+    if (small) {
+        std::vector<std::uint16_t> narrow(g.indices.begin(), g.indices.end());
+        ok = ok && std::fwrite(narrow.data(), sizeof(std::uint16_t), ni, f) == ni;
+    } else {
+        ok = ok && std::fwrite(g.indices.data(), sizeof(std::uint32_t), ni, f) == ni;
+    }
+    ok = (std::fclose(f) == 0) && ok;
+
+    if (!ok) std::fprintf(stderr, "MeshFile: write to %s failed\n", path);
+    return ok;
+}
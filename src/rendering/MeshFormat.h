@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Compact vertex encoding shared by procedural meshes and mesh files.
+//
+//   position: 3 × half float + 1 pad half   (8 bytes, GL_HALF_FLOAT)
+//   normal:   octahedral, 2 × snorm16        (4 bytes, GL_SHORT normalized)
+//
+// 12 bytes instead of 6 floats (24). Indices are 16-bit whenever the vertex
+// count allows. No GL in this file: encoding and the file format only.
+struct PackedVertex {
+    std::uint16_t position[4];  // x, y, z, 1.0
+    std::int16_t  normal[2];    // decode with octDecode() in object.vert
+};
+static_assert(sizeof(PackedVertex) == 12, "must match the VAO attribute formats");
+
+std::uint16_t floatToHalf(float f);
+float         halfToFloat(std::uint16_t h);
+PackedVertex  packVertex(const glm::vec3& position, const glm::vec3& normal);
+
+// CPU-side geometry, ready for upload or writeMeshFile()
+struct MeshGeometry {
+    std::vector<PackedVertex>  vertices;
+    std::vector<std::uint32_t> indices;
+
+    bool fits16() const { return vertices.size() <= 65536; }
+};
+
+// ---------- file format ----------
+//
+//   [MeshFileHeader, 64 bytes]
+//   [vertexCount × PackedVertex]                at vertexOffset
+//   [indexCount × uint16 or uint32, indexSize]  at indexOffset
+//
+// Both blocks start on 64-byte boundaries so a mapped file uploads as-is.
+
+constexpr std::uint32_t kMeshFileVersion   = 1;
+constexpr std::uint32_t kMeshFileAlignment = 64;
+constexpr std::uint32_t kMeshFileEndianTag = 0x01020304u;
+
+struct MeshFileHeader {
+    char          magic[8];      // "3DMESH\0\0"
+    std::uint32_t version;
+    std::uint32_t headerSize;
+    std::uint32_t vertexCount;
+    std::uint32_t indexCount;
+    std::uint32_t vertexStride;  // sizeof(PackedVertex)
+    std::uint32_t indexSize;     // 2 or 4
+    std::uint64_t vertexOffset;
+    std::uint64_t indexOffset;
+    std::uint32_t endianTag;     // kMeshFileEndianTag as written
+    float         boundsRadius;  // about the model-space origin
+    std::uint32_t reserved[2];
+};
+static_assert(sizeof(MeshFileHeader) == 64, "mesh file header layout");
+
+// Validated, non-owning view of mesh file bytes (e.g. a mapped file)
+struct MeshView {
+    const MeshFileHeader* header{nullptr};
+    const unsigned char*  base{nullptr};
+
+    const void* vertices() const { return base + header->vertexOffset; }
+    const void* indices()  const { return base + header->indexOffset; }
+};
+
+// Checks magic, version, layout and size; prints the reason on failure.
+bool openMeshFile(const void* data, std::size_t size, MeshView& out);
+
+bool writeMeshFile(const char* path, const MeshGeometry& geometry);
@@ -0,0 +1,147 @@
+#include "MeshOptimize.h"
+
+namespace {
+
+// Triangles touching each vertex, CSR: tris[start[v] .. start[v + 1])
+struct VertexTriangles {
+    std::vector<std::uint32_t> start;
+    std::vector<std::uint32_t> tris;
+};
+
+VertexTriangles buildAdjacency(const std::vector<std::uint32_t>& indices, std::size_t vertexCount)
+{
+    VertexTriangles adj;
+    adj.start.assign(vertexCount + 1, 0);
+    for (std::uint32_t v : indices) ++adj.start[v + 1];
+    for (std::size_t v = 0; v < vertexCount; ++v) adj.start[v + 1] += adj.start[v];
+
+    adj.tris.resize(indices.size());
+    std::vector<std::uint32_t> fill(adj.start.begin(), adj.start.end() - 1);
+    for (std::size_t i = 0; i < indices.size(); ++i)
+        adj.tris[fill[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+    return adj;
+}
+
+} // namespace
+
+// ---------- analysis ----------
+
+float acmr(const std::vector<std::uint32_t>& indices, std::size_t vertexCount, unsigned cacheSize)
+{
+    if (indices.size() < 3) return 0.0f;
+
+    // FIFO by timestamp: a vertex is cached if it entered fewer than
+    // cacheSize misses ago
+    std::vector<std::uint64_t> entered(vertexCount, 0);
+    std::uint64_t              misses = 0;
+    for (std::uint32_t v : indices) {
+        if (entered[v] == 0 || misses - entered[v] >= cacheSize) {
+            ++misses;
+            entered[v] = misses;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
+
+// ---------- reordering ----------
+
+void optimizeVertexCache(std::vector<std::uint32_t>& indices, std::size_t vertexCount,
+                         unsigned cacheSize)
+{
+    const std::size_t triCount = indices.size() / 3;
+    if (triCount == 0) return;
+
+    const VertexTriangles adj = buildAdjacency(indices, vertexCount);
+
+    std::vector<std::uint32_t> live(vertexCount);  // triangles not yet emitted
+    for (std::size_t v = 0; v < vertexCount; ++v) live[v] = adj.start[v + 1] - adj.start[v];
+
+    std::vector<std::uint64_t> cacheTime(vertexCount, 0);
+    std::vector<bool>          emitted(triCount, false);
+    std::vector<std::uint32_t> deadEnd;     // recently used, for when the fan runs dry
+    std::vector<std::uint32_t> candidates;  // one fan's vertices
+    std::vector<std::uint32_t> out;
+    out.reserve(indices.size());
+
+    std::uint64_t time   = cacheSize + 1;  // everything starts outside the cache
+    std::size_t   cursor = 0;
+    std::int64_t  fan    = 0;
+
+    while (fan >= 0) {
+        const auto f = static_cast<std::uint32_t>(fan);
+        candidates.clear();
+
+        for (std::uint32_t k = adj.start[f]; k < adj.start[f + 1]; ++k) {
+            const std::uint32_t t = adj.tris[k];
+            if (emitted[t]) continue;
+            emitted[t] = true;
+
+            for (int c = 0; c < 3; ++c) {
+                const std::uint32_t v = indices[t * 3 + c];
+                out.push_back(v);
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                --live[v];
+                if (time - cacheTime[v] > cacheSize) cacheTime[v] = time++;
+            }
+        }
+
+        // Next fan: the candidate that stays cached longest while its
+        // remaining triangles are emitted
+        fan = -1;
+        std::int64_t best = -1;
+        for (std::uint32_t v : candidates) {
+            if (live[v] == 0) continue;
+            std::int64_t priority = 0;
+            if (time - cacheTime[v] + 2 * live[v] <= cacheSize)
+                priority = static_cast<std::int64_t>(time - cacheTime[v]);
+            if (priority > best) {
+                best = priority;
+                fan  = v;
+            }
+        }
+        if (fan >= 0) continue;
+
+        // Dead end: the most recent vertex with work left, else the next
+        // unfinished one in index order
+        while (!deadEnd.empty() && fan < 0) {
+            const std::uint32_t v = deadEnd.back();
+            deadEnd.pop_back();
+            if (live[v] > 0) fan = v;
+        }
+        while (fan < 0 && cursor < vertexCount) {
+            if (live[cursor] > 0) fan = static_cast<std::int64_t>(cursor);
+            ++cursor;
+        }
+    }
+
+    indices.swap(out);
+}
+
+void optimizeVertexFetch(MeshGeometry& g)
+{
+    constexpr std::uint32_t kUnused = ~std::uint32_t{0};
+
+    std::vector<std::uint32_t> remap(g.vertices.size(), kUnused);
+    std::vector<PackedVertex>  vertices;
+    vertices.reserve(g.vertices.size());
+
+    for (std::uint32_t& i : g.indices) {
+        if (remap[i] == kUnused) {
+            remap[i] = static_cast<std::uint32_t>(vertices.size());
+            vertices.push_back(g.vertices[i]);
+        }
+        i = remap[i];
+    }
+    g.vertices.swap(vertices);
+}
+
+MeshOptimizeStats optimizeMesh(MeshGeometry& g)
+{
+    MeshOptimizeStats stats;
+    stats.acmrBefore = acmr(g.indices, g.vertices.size());
+    optimizeVertexCache(g.indices, g.vertices.size());
+    optimizeVertexFetch(g);
+    stats.acmrAfter = acmr(g.indices, g.vertices.size());
+    return stats;
+}
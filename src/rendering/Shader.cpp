@@ -1,6 +1,13 @@
 #include "Shader.h"
 
+#include "platform/MappedFile.h"
+
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <cstdio>
@@ -18,6 +25,129 @@ static std::string readFile(const std::string& path)
     return ss.str();
 }
 
+// #define lines after #version (which must stay first), then #line so
+// compiler messages still match the file
+static std::string injectDefines(const std::string& src, const std::vector<std::string>& defines)
+{
+    if (defines.empty()) return src;
+
+    std::size_t at = src.find("#version");
+    at = at == std::string::npos ? 0 : src.find('\n', at);
+    at = at == std::string::npos ? src.size() : at + 1;
+
+    std::size_t line = 1;
+    for (std::size_t i = 0; i < at; ++i) line += src[i] == '\n';
+
+    std::string out = src.substr(0, at);
+    for (const std::string& d : defines)
+        out += "#define " + d + "\n";
+    out += "#line " + std::to_string(line) + "\n";
+    out += src.substr(at);
+    return out;
+}
+
+// ---------- program binary cache ----------
+
+// Cache file: header + the driver's blob, exactly as glGetProgramBinary gave it
+struct ProgramBinaryHeader {
+    char          magic[4];    // "3DPB"
+    std::uint32_t format;      // binaryFormat from glGetProgramBinary
+    std::uint64_t length;      // blob bytes that follow
+};
+
+static constexpr char kBinaryMagic[4] = {'3', 'D', 'P', 'B'};
+
+// FNV-1a over both sources and the driver identity, used as the file name:
+// editing a shader or updating the driver simply misses the old entry
+static std::uint64_t cacheKey(const std::string& vertSrc, const std::string& fragSrc)
+{
+    std::uint64_t h = 14695981039346656037ull;
+    auto mix = [&](const char* s, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            h ^= static_cast<unsigned char>(s[i]);
+            h *= 1099511628211ull;
+        }
+        h ^= 0xFF;  // separator so "ab"+"c" != "a"+"bc"
+        h *= 1099511628211ull;
+    };
+    mix(vertSrc.data(), vertSrc.size());
+    mix(fragSrc.data(), fragSrc.size());
+    for (GLenum e : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+        const auto* str = reinterpret_cast<const char*>(glGetString(e));
+        mix(str ? str : "", str ? std::strlen(str) : 0);
+    }
+    return h;
+}
+
+bool Shader::loadBinary(const std::string& path)
+{
+    // A miss is the normal first-run case; don't let MappedFile report it
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec)) return false;
+
+    MappedFile file;
+    if (!file.open(path.c_str())) return false;
+
+    ProgramBinaryHeader h{};
+    if (file.size() < sizeof(h)) return false;
+    std::memcpy(&h, file.data(), sizeof(h));
+    if (std::memcmp(h.magic, kBinaryMagic, sizeof(kBinaryMagic)) != 0 ||
+        file.size() != sizeof(h) + h.length)
+        return false;
+
+    m_program = glCreateProgram();
+    glProgramBinary(m_program, h.format,
+                    static_cast<const unsigned char*>(file.data()) + sizeof(h),
+                    static_cast<GLsizei>(h.length));
+
+    // Drivers reject binaries from other versions or hardware here
+    GLint ok = 0;
+    glGetProgramiv(m_program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        std::fprintf(stderr, "Shader: cached binary %s rejected by the driver, recompiling\n",
+                     path.c_str());
+        glDeleteProgram(m_program);
+        m_program = 0;
+        return false;
+    }
+    return true;
+}
+
+void Shader::storeBinary(const std::string& path) const
+{
+    GLint length = 0;
+    glGetProgramiv(m_program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<unsigned char> blob(static_cast<std::size_t>(length));
+    GLenum format = 0;
+    glGetProgramBinary(m_program, length, nullptr, &format, blob.data());
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        std::fprintf(stderr, "Shader: cannot write binary cache %s\n", path.c_str());
+        return;
+    }
+
+    ProgramBinaryHeader h{};
+    std::memcpy(h.magic, kBinaryMagic, sizeof(kBinaryMagic));
+    h.format = format;
+    h.length = blob.size();
+
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1 &&
+              std::fwrite(blob.data(), 1, blob.size(), f) == blob.size();
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) {
+        std::fprintf(stderr, "Shader: write to %s failed\n", path.c_str());
+        std::remove(path.c_str());
+    }
+}
+
+// ---------- compile ----------
+
 GLuint Shader::compileShader(GLenum type, const std::string& src)
 {
     GLuint shader = glCreateShader(type);
@@ -36,12 +166,53 @@ GLuint Shader::compileShader(GLenum type, const std::string& src)
     return shader;
 }
 
-Shader::Shader(const std::string& vertPath, const std::string& fragPath)
+Shader::Shader(const std::string& vertPath, const std::string& fragPath,
+               const std::vector<std::string>& defines, const std::string& cacheDir)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+
+    // Defines are part of the source, so they are part of the cache key too
+    const std::string vertSrc = injectDefines(readFile(vertPath), defines);
+    const std::string fragSrc = injectDefines(readFile(fragPath), defines);
+
+    // No binary formats = the driver can't hand programs back; skip the cache
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    const bool useCache = !cacheDir.empty() && formats > 0;
+
+    std::string cachePath;
+    bool        cached = false;
+    if (useCache) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "/%016llx.bin",
+                      static_cast<unsigned long long>(cacheKey(vertSrc, fragSrc)));
+        cachePath = cacheDir + name;
+        cached    = loadBinary(cachePath);
+    }
+    if (!cached) {
+        compileAndLink(vertSrc, fragSrc, useCache);
+        if (useCache) storeBinary(cachePath);
+    }
+
+    reflectUniforms();
+
+    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    std::string variant;
+    for (const std::string& d : defines) variant += " " + d;
+    std::printf("Shader: %s + %s [%s ] %s in %.2f ms\n", vertPath.c_str(), fragPath.c_str(),
+                variant.c_str(), cached ? "loaded from binary cache" : "compiled", ms);
+}
+
+void Shader::compileAndLink(const std::string& vertSrc, const std::string& fragSrc,
+                            bool retrievable)
 {
-    GLuint vert = compileShader(GL_VERTEX_SHADER,   readFile(vertPath));
-    GLuint frag = compileShader(GL_FRAGMENT_SHADER, readFile(fragPath));
+    GLuint vert = compileShader(GL_VERTEX_SHADER,   vertSrc);
+    GLuint frag = compileShader(GL_FRAGMENT_SHADER, fragSrc);
 
     m_program = glCreateProgram();
+    if (retrievable)
+        glProgramParameteri(m_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     glAttachShader(m_program, vert);
     glAttachShader(m_program, frag);
     glLinkProgram(m_program);
@@ -59,6 +230,36 @@ Shader::Shader(const std::string& vertPath, const std::string& fragPath)
     glDeleteShader(frag);
 }
 
+void Shader::reflectUniforms()
+{
+    GLint count = 0, maxLength = 0;
+    glGetProgramiv(m_program, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(m_program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::vector<char> name(static_cast<std::size_t>(std::max(maxLength, 1)));
+    m_uniforms.clear();
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint   size   = 0;
+        GLenum  type   = 0;
+        glGetActiveUniform(m_program, static_cast<GLuint>(i), maxLength, &length,
+                           &size, &type, name.data());
+
+        // Uniform-block members have no location
+        GLint location = glGetUniformLocation(m_program, name.data());
+        if (location < 0) continue;
+
+        // Arrays report "name[0]"; store the bare name
+        std::string key(name.data(), static_cast<std::size_t>(length));
+        if (key.size() > 3 && key.compare(key.size() - 3, 3, "[0]") == 0)
+            key.resize(key.size() - 3);
+        m_uniforms.push_back({std::move(key), location});
+    }
+
+    std::sort(m_uniforms.begin(), m_uniforms.end(),
+              [](const Uniform& a, const Uniform& b) { return a.name < b.name; });
+}
+
 Shader::~Shader()
 {
     glDeleteProgram(m_program);
@@ -69,17 +270,33 @@ void Shader::use() const
     glUseProgram(m_program);
 }
 
-void Shader::setMat4(const char* name, const glm::mat4& m) const
+GLint Shader::uniformLocation(const char* name) const
+{
+    auto before = [](const Uniform& u, const char* n) { return std::strcmp(u.name.c_str(), n) < 0; };
+    auto it     = std::lower_bound(m_uniforms.begin(), m_uniforms.end(), name, before);
+    if (it == m_uniforms.end() || it->name != name) {
+        std::fprintf(stderr, "Shader: no active uniform '%s'\n", name);
+        return -1;
+    }
+    return it->location;
+}
+
+void Shader::setMat4(GLint location, const glm::mat4& m) const
+{
+    glProgramUniformMatrix4fv(m_program, location, 1, GL_FALSE, glm::value_ptr(m));
+}
+
+void Shader::setVec3(GLint location, const glm::vec3& v) const
 {
-    glUniformMatrix4fv(glGetUniformLocation(m_program, name), 1, GL_FALSE, glm::value_ptr(m));
+    glProgramUniform3fv(m_program, location, 1, glm::value_ptr(v));
 }
 
-void Shader::setVec3(const char* name, const glm::vec3& v) const
+void Shader::setFloat(GLint location, float f) const
 {
-    glUniform3fv(glGetUniformLocation(m_program, name), 1, glm::value_ptr(v));
+    glProgramUniform1f(m_program, location, f);
 }
 
-void Shader::setFloat(const char* name, float f) const
+void Shader::setInt(GLint location, int i) const
 {
-    glUniform1f(glGetUniformLocation(m_program, name), f);
+    glProgramUniform1i(m_program, location, i);
 }
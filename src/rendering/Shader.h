@@ -3,22 +3,53 @@
 #include <glad/gl.h>
 #include <glm/glm.hpp>
 #include <string>
+#include <vector>
 
+// Linked program plus its active uniforms, reflected once at link time.
+// Look a location up by name during setup, then set by handle: the per-draw
+// path does no string lookups and no glUseProgram (glProgramUniform*).
+//
+// `defines` are feature switches ("NAME" or "NAME VALUE") injected as
+// #define lines right after each stage's #version line; see the top of
+// shaders/object.vert for the ones it understands. Get variants through
+// ShaderLibrary so each define set is built once.
+//
+// With a cacheDir, the linked program binary is stored there keyed by a hash
+// of both sources and the GL vendor/renderer/version, and later launches
+// load it with glProgramBinary instead of compiling; a rejected or stale
+// binary falls back to compiling (and is rewritten).
 class Shader {
 public:
-    Shader(const std::string& vertPath, const std::string& fragPath);
+    Shader(const std::string& vertPath, const std::string& fragPath,
+           const std::vector<std::string>& defines = {},
+           const std::string& cacheDir = {});
     ~Shader();
 
     Shader(const Shader&)            = delete;
     Shader& operator=(const Shader&) = delete;
 
     void use() const;
-    void setMat4(const char* name, const glm::mat4& m) const;
-    void setVec3(const char* name, const glm::vec3& v) const;
-    void setFloat(const char* name, float f) const;
+
+    // -1 (and a warning) if the program has no such active uniform
+    GLint uniformLocation(const char* name) const;
+
+    void setMat4(GLint location, const glm::mat4& m) const;
+    void setVec3(GLint location, const glm::vec3& v) const;
+    void setFloat(GLint location, float f) const;
+    void setInt(GLint location, int i) const;
 
 private:
-    GLuint m_program{0};
+    struct Uniform {
+        std::string name;
+        GLint       location;
+    };
+
+    GLuint               m_program{0};
+    std::vector<Uniform> m_uniforms;  // sorted by name
 
+    void reflectUniforms();
+    bool loadBinary(const std::string& path);
+    void storeBinary(const std::string& path) const;
+    void compileAndLink(const std::string& vertSrc, const std::string& fragSrc, bool retrievable);
     static GLuint compileShader(GLenum type, const std::string& src);
 };
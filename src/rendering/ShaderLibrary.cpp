@@ -0,0 +1,20 @@
+#include "ShaderLibrary.h"
+
+#include <algorithm>
+
+Shader& ShaderLibrary::get(const std::string& vertPath, const std::string& fragPath,
+                           std::vector<std::string> defines)
+{
+    std::sort(defines.begin(), defines.end());
+    defines.erase(std::unique(defines.begin(), defines.end()), defines.end());
+
+    std::string key = vertPath + '\0' + fragPath;
+    for (const std::string& d : defines)
+        key += '\0' + d;
+
+    auto it = m_variants.find(key);
+    if (it == m_variants.end())
+        it = m_variants.emplace(key, std::make_unique<Shader>(vertPath, fragPath, defines,
+                                                              m_cacheDir)).first;
+    return *it->second;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Shader.h"
+
+// Shader variants keyed by (vertex path, fragment path, define set).
+// The define set is sorted first, so {"A", "B"} and {"B", "A"} share one
+// program. Programs live as long as the library; references stay valid.
+class ShaderLibrary {
+public:
+    explicit ShaderLibrary(std::string cacheDir = {}) : m_cacheDir(std::move(cacheDir)) {}
+
+    Shader& get(const std::string& vertPath, const std::string& fragPath,
+                std::vector<std::string> defines = {});
+
+    std::size_t size() const { return m_variants.size(); }
+
+private:
+    std::string                                    m_cacheDir;  // program binaries
+    std::map<std::string, std::unique_ptr<Shader>> m_variants;
+};
@@ -0,0 +1,100 @@
+#include "StreamBuffer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+StreamBuffer::StreamBuffer()
+{
+    // Region offsets must satisfy every target the ring may be bound to
+    GLint ubo = 0, ssbo = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &ubo);
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &ssbo);
+    m_alignment = static_cast<std::size_t>(std::max({ubo, ssbo, GLint{64}}));
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    for (GLsync& f : m_fences)
+        if (f) glDeleteSync(f);
+    if (m_buffer) glDeleteBuffers(1, &m_buffer);  // also unmaps
+}
+
+void StreamBuffer::allocate(std::size_t regionSize)
+{
+    // Pending fences guard the old buffer, which the driver keeps alive
+    // until the GPU is done with it
+    for (GLsync& f : m_fences) {
+        if (f) glDeleteSync(f);
+        f = nullptr;
+    }
+    if (m_buffer) glDeleteBuffers(1, &m_buffer);
+
+    m_regionSize = (regionSize + m_alignment - 1) / m_alignment * m_alignment;
+    m_region     = 0;
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    const auto       total = static_cast<GLsizeiptr>(m_regionSize * kRegions);
+
+    glCreateBuffers(1, &m_buffer);
+    glNamedBufferStorage(m_buffer, total, nullptr, flags);
+    m_mapped = static_cast<unsigned char*>(glMapNamedBufferRange(m_buffer, 0, total, flags));
+    if (!m_mapped) {
+        std::fprintf(stderr, "StreamBuffer: failed to map %zu bytes\n",
+                     static_cast<std::size_t>(total));
+        std::exit(1);
+    }
+}
+
+void StreamBuffer::waitRegion(int region)
+{
+    GLsync& fence = m_fences[region];
+    if (!fence) return;
+
+    // Normal case: the GPU finished this region two frames ago
+    GLenum r = glClientWaitSync(fence, 0, 0);
+    if (r == GL_TIMEOUT_EXPIRED) {
+        using Clock = std::chrono::steady_clock;
+        const auto start = Clock::now();
+        do {
+            r = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);  // 1 ms
+        } while (r == GL_TIMEOUT_EXPIRED);
+
+        ++m_stalls;
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        std::fprintf(stderr, "StreamBuffer: GPU %d frames behind at frame %llu, waited %.2f ms (%llu stalls)\n",
+                     kRegions - 1, static_cast<unsigned long long>(m_frame), ms,
+                     static_cast<unsigned long long>(m_stalls));
+    }
+    if (r == GL_WAIT_FAILED)
+        std::fprintf(stderr, "StreamBuffer: fence wait failed\n");
+
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+void* StreamBuffer::map(std::size_t size)
+{
+    if (size > m_regionSize)
+        allocate(std::max(size + size / 2, m_regionSize * 2));
+
+    waitRegion(m_region);
+    return m_mapped + static_cast<std::size_t>(m_region) * m_regionSize;
+}
+
+void StreamBuffer::bindRange(GLenum target, GLuint binding, std::size_t offset,
+                             std::size_t size) const
+{
+    glBindBufferRange(target, binding, m_buffer, static_cast<GLintptr>(regionOffset() + offset),
+                      static_cast<GLsizeiptr>(size));
+}
+
+void StreamBuffer::endFrame()
+{
+    if (!m_buffer) return;
+
+    m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_region = (m_region + 1) % kRegions;
+    ++m_frame;
+}
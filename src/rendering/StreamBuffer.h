@@ -0,0 +1,55 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <cstddef>
+#include <cstdint>
+
+// Persistently mapped ring for data rewritten every frame.
+//
+// One immutable buffer split into kRegions equal regions, each guarded by a
+// fence placed after the frame that used it. The CPU fills region N+2 while
+// the GPU still reads N and N+1; map() only blocks when the GPU is a full
+// ring behind, and every such wait is counted and printed.
+class StreamBuffer {
+public:
+    static constexpr int kRegions = 3;
+
+    StreamBuffer();
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&)            = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    // Write pointer into this frame's region, valid until endFrame().
+    // Grows the ring (new buffer, old one released by the driver) when
+    // size exceeds the region.
+    void* map(std::size_t size);
+
+    // Bind `size` bytes at `offset` into this frame's region; offset must be
+    // a multiple of alignment()
+    void bindRange(GLenum target, GLuint binding, std::size_t offset, std::size_t size) const;
+
+    // For non-indexed targets (GL_DRAW_INDIRECT_BUFFER): the buffer and the
+    // byte offset of this frame's region within it
+    GLuint      buffer() const { return m_buffer; }
+    std::size_t regionOffset() const { return static_cast<std::size_t>(m_region) * m_regionSize; }
+    std::size_t alignment() const { return m_alignment; }
+
+    // Fence this frame's region after its draws and advance to the next
+    void endFrame();
+
+    std::uint64_t stalls() const { return m_stalls; }
+
+private:
+    void allocate(std::size_t regionSize);
+    void waitRegion(int region);
+
+    GLuint         m_buffer{0};
+    unsigned char* m_mapped{nullptr};
+    std::size_t    m_regionSize{0};   // multiple of m_alignment
+    std::size_t    m_alignment{256};  // region offsets are bindable
+    int            m_region{0};
+    GLsync         m_fences[kRegions]{};
+    std::uint64_t  m_frame{0};
+    std::uint64_t  m_stalls{0};
+};
@@ -0,0 +1,25 @@
+#include "UniformBuffer.h"
+
+#include <algorithm>
+
+UniformBuffer::UniformBuffer(std::size_t size)
+    : m_size(size)
+{
+    glCreateBuffers(1, &m_ubo);
+    glNamedBufferStorage(m_ubo, static_cast<GLsizeiptr>(size), nullptr, GL_DYNAMIC_STORAGE_BIT);
+}
+
+UniformBuffer::~UniformBuffer()
+{
+    glDeleteBuffers(1, &m_ubo);
+}
+
+void UniformBuffer::update(const void* data, std::size_t size)
+{
+    glNamedBufferSubData(m_ubo, 0, static_cast<GLsizeiptr>(std::min(size, m_size)), data);
+}
+
+void UniformBuffer::bind(GLuint binding) const
+{
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_ubo);
+}
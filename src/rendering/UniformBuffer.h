@@ -0,0 +1,34 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+
+// Uniform block binding points shared by every program (layout(binding = N))
+constexpr GLuint kFrameUniformBinding = 0;
+
+// Per-frame camera + lighting; std140 layout of the `Frame` block in shaders/
+struct FrameUniforms {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::vec4 lightDir;    // xyz, normalized, points from the light
+    glm::vec4 lightColor;  // rgb; a = ambient strength
+};
+static_assert(sizeof(FrameUniforms) == 160, "must match the std140 Frame block");
+
+// Fixed-size uniform buffer, updated in place
+class UniformBuffer {
+public:
+    explicit UniformBuffer(std::size_t size);
+    ~UniformBuffer();
+
+    UniformBuffer(const UniformBuffer&)            = delete;
+    UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+    void update(const void* data, std::size_t size);
+    void bind(GLuint binding) const;
+
+private:
+    GLuint      m_ubo{0};
+    std::size_t m_size{0};
+};
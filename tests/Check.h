@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdio>
+
+// Minimal assertion for the core tests: reports and counts failures so one
+// run shows all of them; main() returns checkFailures() != 0.
+inline int& checkFailures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(cond)                                                   \
+    do {                                                              \
+        if (!(cond)) {                                                \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n",         \
+                         __FILE__, __LINE__, #cond);                  \
+            ++checkFailures();                                        \
+        }                                                             \
+    } while (0)
@@ -0,0 +1,63 @@
+#include "core/FrameArena.h"
+#include "Check.h"
+
+static void trimReleasesTail()
+{
+    FrameArena arena(64 << 10);
+
+    // 100 floats pad out to 448 bytes; trimmed to 10 they fit one line
+    std::span<float> list = arena.alloc<float>(100);
+    CHECK(arena.used() == 448);
+
+    list = arena.trim(list, 10);
+    CHECK(list.size() == 10);
+    CHECK(arena.used() == FrameArena::kAlignment);
+
+    // The freed bytes are handed out again, right after the trimmed list
+    std::span<float> next = arena.alloc<float>(16);
+    CHECK(reinterpret_cast<unsigned char*>(next.data()) ==
+          reinterpret_cast<unsigned char*>(list.data()) + FrameArena::kAlignment);
+    CHECK(arena.used() == 2 * FrameArena::kAlignment);
+}
+
+static void trimToZero()
+{
+    FrameArena arena(64 << 10);
+    std::span<int> list = arena.alloc<int>(1000);
+    list = arena.trim(list, 0);
+    CHECK(list.empty());
+    CHECK(arena.used() == 0);
+}
+
+static void trimOlderAllocationOnlyNarrows()
+{
+    FrameArena arena(64 << 10);
+    std::span<int> older = arena.alloc<int>(100);
+    arena.alloc<int>(100);
+    const std::size_t used = arena.used();
+
+    older = arena.trim(older, 5);
+    CHECK(older.size() == 5);
+    CHECK(arena.used() == used);
+}
+
+static void trimOverflowOnlyNarrows()
+{
+    FrameArena arena(256);
+    arena.alloc<float>(64);                            // fills the block
+    std::span<float> spill = arena.alloc<float>(100);  // from the heap
+    const std::size_t used = arena.used();
+
+    spill = arena.trim(spill, 10);
+    CHECK(spill.size() == 10);
+    CHECK(arena.used() == used);
+}
+
+int main()
+{
+    trimReleasesTail();
+    trimToZero();
+    trimOlderAllocationOnlyNarrows();
+    trimOverflowOnlyNarrows();
+    return checkFailures() != 0;
+}
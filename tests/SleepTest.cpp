@@ -0,0 +1,86 @@
+#include "core/Physics.h"
+#include "core/Simulation.h"
+#include "core/Sleep.h"
+#include "bench/Scenes.h"
+#include "Check.h"
+
+constexpr float kDt = 1.0f / 60.0f;
+
+// A settled pile must stay asleep: resting neighbours don't wake each other
+static void pileSettles()
+{
+    SimState sim;
+    sim.params.restitution = 0.2f;
+    sim.params.friction    = 0.3f;
+    spawnLattice(sim, 64);
+
+    int asleepFrom = -1;
+    for (int t = 0; t < 30 * 60; ++t) {
+        stepSimulation(sim, kDt);
+        if (sim.stats.awakeBodies == 0 && asleepFrom < 0) asleepFrom = t;
+        if (sim.stats.awakeBodies != 0) asleepFrom = -1;
+    }
+    CHECK(asleepFrom >= 0);
+}
+
+// Sleeper at b, awake body at a touching it, set up as wakeTouchedBodies
+// sees them: after integration, before the solve
+static BodyStore touchingPair(glm::vec3 velocityA, float sleepTimerA)
+{
+    BodyStore s;
+    s.push_back(makeSphere({0.0f, 0.5f, 0.0f}, 0.5f, 1.0f));
+    s.push_back(makeSphere({0.9f, 0.5f, 0.0f}, 0.5f, 1.0f));
+    s.setVelocity(0, velocityA);
+    s.sleepTimer[0] = sleepTimerA;
+    s.awake[1]      = 0.0f;
+    s.sleepTimer[1] = 1.0f;
+    return s;
+}
+
+static void movingBodyWakesSleeper()
+{
+    const SimParams p;
+    const Contact   c{0, 1, 1.0f, 0.0f, 0.0f, 0.1f};
+
+    // Resting: only this tick's gravity, below the thresholds for a while
+    BodyStore rest = touchingPair(p.gravity * kDt, 0.2f);
+    wakeTouchedBodies(rest, std::span(&c, 1), p, kDt);
+    CHECK(!rest.isAwake(1));
+
+    // Rolling into it
+    BodyStore rolling = touchingPair(glm::vec3{1.0f, 0.0f, 0.0f} + p.gravity * kDt, 0.2f);
+    wakeTouchedBodies(rolling, std::span(&c, 1), p, kDt);
+    CHECK(rolling.isAwake(1));
+
+    // Above the thresholds last tick (timer reset), slowing now
+    BodyStore slowing = touchingPair(p.gravity * kDt, 0.0f);
+    wakeTouchedBodies(slowing, std::span(&c, 1), p, kDt);
+    CHECK(slowing.isAwake(1));
+
+    // Static bodies never wake what rests on them
+    BodyStore ground = touchingPair(glm::vec3{0.0f}, 0.0f);
+    ground.invMass[0] = 0.0f;
+    wakeTouchedBodies(ground, std::span(&c, 1), p, kDt);
+    CHECK(!ground.isAwake(1));
+
+    // End to end: a moving body knocks into a sleeper
+    SimState sim;
+    sim.bodies.push_back(makeSphere({0.0f, 0.5f, 0.0f}, 0.5f, 1.0f));
+    sim.bodies.push_back(makeSphere({-3.0f, 0.5f, 0.0f}, 0.5f, 1.0f));
+    sim.bodies.awake[0]      = 0.0f;
+    sim.bodies.sleepTimer[0] = 1.0f;
+    sim.bodies.setVelocity(1, {5.0f, 0.0f, 0.0f});
+    bool woke = false;
+    for (int t = 0; t < 60 && !woke; ++t) {
+        stepSimulation(sim, kDt);
+        woke = sim.bodies.isAwake(0);
+    }
+    CHECK(woke);
+}
+
+int main()
+{
+    pileSettles();
+    movingBodyWakesSleeper();
+    return checkFailures() != 0;
+}